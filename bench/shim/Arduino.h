@@ -0,0 +1,147 @@
+// ============================================================================
+// Arduino.h - Host stand-in for the Arduino core, for src/host_bench.cpp
+// ============================================================================
+//
+// Only what the game uses outside its #ifdef ARDUINO blocks: the clock,
+// random(), String, Serial (to stdout), ESP heap figures and the tone pins.
+// The bench is a single translation unit, so everything is defined here.
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#define PROGMEM
+#define IRAM_ATTR
+#define PI 3.1415926535897932384626433832795
+#define HIGH 1
+#define LOW 0
+#define OUTPUT 1
+#define DEC 10
+#define HEX 16
+
+using std::max;
+using std::min;
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// ---- Time ------------------------------------------------------------------
+
+static const std::chrono::steady_clock::time_point hostStart = std::chrono::steady_clock::now();
+
+inline unsigned long micros()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - hostStart).count();
+}
+
+inline unsigned long millis() { return micros() / 1000; }
+
+inline void delay(unsigned long ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+inline void delayMicroseconds(unsigned int us) { std::this_thread::sleep_for(std::chrono::microseconds(us)); }
+
+// ---- Random ----------------------------------------------------------------
+
+inline long random(long howBig) { return howBig > 0 ? rand() % howBig : 0; }
+inline long random(long howSmall, long howBig) { return howSmall < howBig ? random(howBig - howSmall) + howSmall : howSmall; }
+inline void randomSeed(unsigned long seed)
+{
+  if (seed)
+    srand(seed);
+}
+inline uint32_t esp_random() { return ((uint32_t)rand() << 16) ^ (uint32_t)rand(); }
+
+// ---- Pins and tones --------------------------------------------------------
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline double ledcSetup(uint8_t, double freq, uint8_t) { return freq; }
+inline void ledcAttachPin(uint8_t, uint8_t) {}
+inline double ledcWriteTone(uint8_t, double freq) { return freq; }
+
+// ---- String ----------------------------------------------------------------
+
+class String
+{
+private:
+  std::string s;
+
+public:
+  String() {}
+  String(const char *c) : s(c ? c : "") {}
+  String(int v) : s(std::to_string(v)) {}
+  String(unsigned v) : s(std::to_string(v)) {}
+  String(long v) : s(std::to_string(v)) {}
+  String(unsigned long v) : s(std::to_string(v)) {}
+  String(float v) : s(std::to_string(v)) {}
+
+  String operator+(const String &o) const { return String((s + o.s).c_str()); }
+  friend String operator+(const char *a, const String &b) { return String(a) + b; }
+  const char *c_str() const { return s.c_str(); }
+  size_t length() const { return s.size(); }
+};
+
+// ---- Serial ----------------------------------------------------------------
+
+class HardwareSerial
+{
+public:
+  void begin(unsigned long) {}
+  operator bool() const { return true; }
+
+  size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)))
+  {
+    va_list args;
+    va_start(args, fmt);
+    int n = vprintf(fmt, args);
+    va_end(args);
+    return n;
+  }
+
+  size_t print(const char *s) { return fputs(s, stdout) < 0 ? 0 : strlen(s); }
+  size_t print(const String &s) { return print(s.c_str()); }
+  size_t print(long v, int base = DEC) { return base == HEX ? printf("%lx", v) : printf("%ld", v); }
+  size_t print(int v, int base = DEC) { return print((long)v, base); }
+  size_t print(unsigned long v, int base = DEC) { return base == HEX ? printf("%lx", v) : printf("%lu", v); }
+  size_t print(unsigned v, int base = DEC) { return print((unsigned long)v, base); }
+  size_t print(double v, int digits = 2) { return printf("%.*f", digits, v); }
+
+  size_t println() { return print("\n"); }
+  template <class T>
+  size_t println(T v)
+  {
+    return print(v) + println();
+  }
+
+  size_t write(uint8_t c) { return putchar(c) == EOF ? 0 : 1; }
+  size_t write(const uint8_t *data, size_t n) { return fwrite(data, 1, n, stdout); }
+  int availableForWrite() { return 128; }
+  int available() { return 0; }
+  int read() { return -1; }
+  void flush() { fflush(stdout); }
+};
+
+HardwareSerial Serial;
+
+// ---- ESP -------------------------------------------------------------------
+
+class EspClass
+{
+public:
+  uint32_t getFreeHeap() { return 0; }
+  uint32_t getMinFreeHeap() { return 0; }
+  uint32_t getPsramSize() { return 0; }
+  uint32_t getFreePsram() { return 0; }
+  uint32_t getCycleCount() { return micros() * 240; }
+  void restart() { exit(1); }
+};
+
+EspClass ESP;
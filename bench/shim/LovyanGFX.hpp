@@ -0,0 +1,327 @@
+// ============================================================================
+// LovyanGFX.hpp - Host stand-in for LovyanGFX, for src/host_bench.cpp
+// ============================================================================
+//
+// Sprites are real 16-bit buffers and the primitives the game uses write
+// every pixel they cover, so draw code does the same memory work it does
+// on the device. Pixels are stored byte-swapped as LovyanGFX does.
+// Panel, bus and touch configuration is accepted and ignored; the display
+// has no buffer, so drawing to it does nothing.
+//
+// Text is drawn with a made-up 5x7 glyph per character in a 6x8 cell: the
+// same shape of work as the built-in font, not the same letters.
+
+#pragma once
+
+#include <Arduino.h>
+
+enum
+{
+  TFT_BLACK = 0x0000,
+  TFT_BLUE = 0x001F,
+  TFT_GREEN = 0x07E0,
+  TFT_CYAN = 0x07FF,
+  TFT_RED = 0xF800,
+  TFT_MAGENTA = 0xF81F,
+  TFT_YELLOW = 0xFFE0,
+  TFT_WHITE = 0xFFFF,
+  TFT_PURPLE = 0x780F,
+  TFT_ORANGE = 0xFDA0,
+  TFT_DARKGREY = 0x7BEF,
+  TFT_LIGHTGREY = 0xD69A
+};
+
+// Low two bits horizontal (left, centre, right), the next two vertical
+// (top, middle, bottom)
+enum
+{
+  TL_DATUM = 0,
+  TC_DATUM = 1,
+  TR_DATUM = 2,
+  ML_DATUM = 4,
+  MC_DATUM = 5,
+  MR_DATUM = 6,
+  BL_DATUM = 8,
+  BC_DATUM = 9,
+  BR_DATUM = 10
+};
+
+#define SPI2_HOST 1
+#define SPI3_HOST 2
+#define SPI_DMA_CH_AUTO 3
+
+namespace lgfx
+{
+struct config_t
+{
+  int spi_host, spi_mode, dma_channel;
+  uint32_t freq_write, freq_read, freq;
+  bool spi_3wire, use_lock, readable, invert, rgb_order, dlen_16bit, bus_shared;
+  int pin_sclk, pin_mosi, pin_miso, pin_dc, pin_cs, pin_rst, pin_busy, pin_int, pin_sda, pin_scl;
+  int memory_width, memory_height, panel_width, panel_height;
+  int offset_x, offset_y, offset_rotation, dummy_read_pixel, dummy_read_bits;
+  int x_min, x_max, y_min, y_max, i2c_port, i2c_addr;
+};
+
+struct Bus_SPI
+{
+  config_t cfg = {};
+  config_t config() const { return cfg; }
+  void config(const config_t &c) { cfg = c; }
+};
+
+struct Touch_FT5x06 : Bus_SPI
+{
+};
+
+struct Light_PWM : Bus_SPI
+{
+};
+
+struct Panel_ILI9488 : Bus_SPI
+{
+  void setBus(Bus_SPI *) {}
+  void setTouch(Touch_FT5x06 *) {}
+  void setLight(Light_PWM *) {}
+};
+
+struct touch_point_t
+{
+  int16_t x, y;
+  uint16_t size, id;
+};
+
+class LGFXBase
+{
+protected:
+  uint16_t *buffer = nullptr;
+  int w = 0, h = 0;
+  uint16_t textFg = TFT_WHITE, textBg = TFT_BLACK;
+  bool textFill = false;
+  uint8_t datum = TL_DATUM;
+  int textSize = 1;
+
+  static uint16_t swap(uint32_t c) { return (uint16_t)((c >> 8 & 0xFF) | (c & 0xFF) << 8); }
+
+  void span(int x0, int x1, int y, uint16_t c)
+  {
+    if (y < 0 || y >= h)
+      return;
+    x0 = max(x0, 0);
+    x1 = min(x1, w - 1);
+    for (int x = x0; x <= x1; x++)
+      buffer[y * w + x] = c;
+  }
+
+  void glyph(char ch, int x, int y, uint16_t fg, uint16_t bg)
+  {
+    uint32_t bits = (uint32_t)(uint8_t)ch * 2654435761u;
+    for (int gy = 0; gy < 8; gy++)
+      for (int gx = 0; gx < 6; gx++)
+      {
+        bool on = gx < 5 && gy < 7 && (bits >> ((gy * 5 + gx) % 32) & 1);
+        if (on || textFill)
+          fillRect(x + gx * textSize, y + gy * textSize, textSize, textSize, on ? fg : bg);
+      }
+  }
+
+public:
+  int width() const { return w; }
+  int height() const { return h; }
+  void startWrite() {}
+  void endWrite() {}
+
+  void fillScreen(uint32_t color) { fillRect(0, 0, w, h, color); }
+
+  void drawPixel(int x, int y, uint32_t color)
+  {
+    if (buffer && x >= 0 && y >= 0 && x < w && y < h)
+      buffer[y * w + x] = swap(color);
+  }
+
+  void fillRect(int x, int y, int rw, int rh, uint32_t color)
+  {
+    if (!buffer)
+      return;
+    uint16_t c = swap(color);
+    int y1 = min(y + rh, h);
+    for (int yy = max(y, 0); yy < y1; yy++)
+      span(x, x + rw - 1, yy, c);
+  }
+
+  void drawFastHLine(int x, int y, int len, uint32_t color) { fillRect(x, y, len, 1, color); }
+  void drawFastVLine(int x, int y, int len, uint32_t color) { fillRect(x, y, 1, len, color); }
+
+  void drawRect(int x, int y, int rw, int rh, uint32_t color)
+  {
+    drawFastHLine(x, y, rw, color);
+    drawFastHLine(x, y + rh - 1, rw, color);
+    drawFastVLine(x, y, rh, color);
+    drawFastVLine(x + rw - 1, y, rh, color);
+  }
+
+  void fillCircle(int cx, int cy, int r, uint32_t color)
+  {
+    if (!buffer)
+      return;
+    uint16_t c = swap(color);
+    for (int dy = -r; dy <= r; dy++)
+    {
+      int dx = (int)sqrtf((float)(r * r - dy * dy) + 0.5f);
+      span(cx - dx, cx + dx, cy + dy, c);
+    }
+  }
+
+  void drawCircle(int cx, int cy, int r, uint32_t color)
+  {
+    int x = r, y = 0, err = 1 - r;
+    while (x >= y)
+    {
+      drawPixel(cx + x, cy + y, color);
+      drawPixel(cx - x, cy + y, color);
+      drawPixel(cx + x, cy - y, color);
+      drawPixel(cx - x, cy - y, color);
+      drawPixel(cx + y, cy + x, color);
+      drawPixel(cx - y, cy + x, color);
+      drawPixel(cx + y, cy - x, color);
+      drawPixel(cx - y, cy - x, color);
+      y++;
+      if (err < 0)
+        err += 2 * y + 1;
+      else
+      {
+        x--;
+        err += 2 * (y - x) + 1;
+      }
+    }
+  }
+
+  void fillTriangle(int x0, int y0, int x1, int y1, int x2, int y2, uint32_t color)
+  {
+    if (!buffer)
+      return;
+    if (y0 > y1)
+      std::swap(y0, y1), std::swap(x0, x1);
+    if (y1 > y2)
+      std::swap(y1, y2), std::swap(x1, x2);
+    if (y0 > y1)
+      std::swap(y0, y1), std::swap(x0, x1);
+    uint16_t c = swap(color);
+    for (int y = y0; y <= y2; y++)
+    {
+      float a = y2 == y0 ? x0 : x0 + (float)(x2 - x0) * (y - y0) / (y2 - y0);
+      float b = y < y1 ? (y1 == y0 ? x1 : x0 + (float)(x1 - x0) * (y - y0) / (y1 - y0))
+                       : (y2 == y1 ? x1 : x1 + (float)(x2 - x1) * (y - y1) / (y2 - y1));
+      span((int)min(a, b), (int)max(a, b), y, c);
+    }
+  }
+
+  // Image pixels are plain RGB565 and are swapped on the way in
+  template <class T>
+  void pushImage(int x, int y, int iw, int ih, const T *data)
+  {
+    pushImage(x, y, iw, ih, data, 0x10000);
+  }
+
+  // Pixels equal to transparent are skipped
+  template <class T>
+  void pushImage(int x, int y, int iw, int ih, const T *data, uint32_t transparent)
+  {
+    if (!buffer)
+      return;
+    const uint16_t *src = (const uint16_t *)data;
+    int x0 = max(x, 0), x1 = min(x + iw, w);
+    int y0 = max(y, 0), y1 = min(y + ih, h);
+    for (int yy = y0; yy < y1; yy++)
+      for (int xx = x0; xx < x1; xx++)
+      {
+        uint16_t p = src[(yy - y) * iw + (xx - x)];
+        if (p != transparent)
+          buffer[yy * w + xx] = swap(p);
+      }
+  }
+
+  void setTextColor(uint32_t fg)
+  {
+    textFg = fg;
+    textFill = false;
+  }
+
+  void setTextColor(uint32_t fg, uint32_t bg)
+  {
+    textFg = fg;
+    textBg = bg;
+    textFill = true;
+  }
+
+  void setTextDatum(uint8_t d) { datum = d; }
+  void setTextSize(float size) { textSize = max(1, (int)size); }
+  int32_t textWidth(const char *s) const { return 6 * textSize * (int32_t)strlen(s); }
+  int32_t fontHeight() const { return 8 * textSize; }
+
+  size_t drawString(const char *s, int x, int y)
+  {
+    int tw = textWidth(s), th = fontHeight();
+    x -= (datum & 3) * tw / 2;
+    y -= (datum >> 2 & 3) * th / 2;
+    if (buffer)
+      for (const char *p = s; *p; p++, x += 6 * textSize)
+        glyph(*p, x, y, textFg, textBg);
+    return tw;
+  }
+
+  size_t drawString(const String &s, int x, int y) { return drawString(s.c_str(), x, y); }
+
+  uint16_t color565(uint8_t r, uint8_t g, uint8_t b) { return (r & 0xF8) << 8 | (g & 0xFC) << 3 | b >> 3; }
+};
+
+class LGFX_Device : public LGFXBase
+{
+public:
+  bool init()
+  {
+    w = 320;
+    h = 480;
+    return true;
+  }
+  void setPanel(Panel_ILI9488 *) {}
+  void setRotation(uint8_t) {}
+  void setBrightness(uint8_t) {}
+  bool getTouch(uint16_t *, uint16_t *) { return false; }
+  int getTouchRaw(touch_point_t *, int) { return 0; }
+};
+} // namespace lgfx
+
+class LGFX_Sprite : public lgfx::LGFXBase
+{
+public:
+  LGFX_Sprite(lgfx::LGFXBase * = nullptr) {}
+  ~LGFX_Sprite() { deleteSprite(); }
+
+  void setColorDepth(int) {}
+  void setPsram(bool) {}
+
+  void *createSprite(int width, int height)
+  {
+    deleteSprite();
+    buffer = (uint16_t *)calloc((size_t)width * height, sizeof(uint16_t));
+    if (buffer)
+    {
+      w = width;
+      h = height;
+    }
+    return buffer;
+  }
+
+  void deleteSprite()
+  {
+    free(buffer);
+    buffer = nullptr;
+    w = h = 0;
+  }
+
+  void *getBuffer() const { return buffer; }
+  void fillSprite(uint32_t color) { fillScreen(color); }
+  void pushSprite(int, int) {}
+  void pushSprite(lgfx::LGFXBase *, int, int) {}
+};
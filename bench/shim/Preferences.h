@@ -0,0 +1,68 @@
+// ============================================================================
+// Preferences.h - Host stand-in for the ESP32 NVS store, kept in memory
+// ============================================================================
+
+#pragma once
+
+#include <Arduino.h>
+#include <map>
+#include <vector>
+
+class Preferences
+{
+private:
+  std::string space;
+
+  static std::map<std::string, std::vector<uint8_t>> &store()
+  {
+    static std::map<std::string, std::vector<uint8_t>> values;
+    return values;
+  }
+
+  std::vector<uint8_t> *find(const char *key)
+  {
+    auto it = store().find(space + "/" + key);
+    return it == store().end() ? nullptr : &it->second;
+  }
+
+public:
+  bool begin(const char *name, bool = false)
+  {
+    space = name;
+    return true;
+  }
+
+  void end() {}
+
+  size_t getBytesLength(const char *key)
+  {
+    std::vector<uint8_t> *v = find(key);
+    return v ? v->size() : 0;
+  }
+
+  size_t getBytes(const char *key, void *buf, size_t len)
+  {
+    std::vector<uint8_t> *v = find(key);
+    if (!v || v->size() > len)
+      return 0;
+    memcpy(buf, v->data(), v->size());
+    return v->size();
+  }
+
+  size_t putBytes(const char *key, const void *value, size_t len)
+  {
+    const uint8_t *p = (const uint8_t *)value;
+    store()[space + "/" + key].assign(p, p + len);
+    return len;
+  }
+
+  uint32_t getUInt(const char *key, uint32_t defaultValue = 0)
+  {
+    uint32_t v;
+    return getBytes(key, &v, sizeof(v)) == sizeof(v) ? v : defaultValue;
+  }
+
+  size_t putUInt(const char *key, uint32_t value) { return putBytes(key, &value, sizeof(value)); }
+
+  bool remove(const char *key) { return store().erase(space + "/" + key) > 0; }
+};
@@ -0,0 +1,104 @@
+// ============================================================================
+// aabb_kernel.h - Batched box overlap tests, one box against many
+// ============================================================================
+//
+// Candidate boxes are kept as structure-of-arrays edges (x0, y0, x1, y1)
+// so one query box can be tested against four of them per step. The
+// result is a bitmask, bit i set when box i overlaps.
+//
+// overlapScalar() and overlapVector() give identical masks: both do the
+// same float compares, the vector version four lanes at a time through
+// GCC vector extensions. Four lanes fill one 128-bit register (SSE2,
+// NEON), which measured faster on x86 than eight split in two halves.
+// Where the target has no matching SIMD unit GCC lowers the vector code to
+// scalar instructions, so it is always safe to call. Unused lanes hold an
+// inverted box that can never overlap.
+//
+// overlap() picks the one to use in game code: scalar on Xtensa, which has
+// no float SIMD for GCC to target, vector everywhere else.
+
+#pragma once
+
+#include <Arduino.h>
+#include <float.h>
+
+#define AABB_GROUP 4
+
+typedef float aabb_f4 __attribute__((vector_size(AABB_GROUP * sizeof(float))));
+typedef int32_t aabb_i4 __attribute__((vector_size(AABB_GROUP * sizeof(int32_t))));
+
+// Up to N boxes, N at most 32 so a mask fits in 32 bits. MAX_ENEMIES is
+// bound by this; tools/pool_sizing.py clamps it to match.
+template <int N>
+struct AabbSoA
+{
+  static_assert(N > 0 && N <= 32, "masks are 32 bits");
+  static const int LANES = (N + AABB_GROUP - 1) / AABB_GROUP * AABB_GROUP;
+
+  alignas(16) float x0[LANES];
+  alignas(16) float y0[LANES];
+  alignas(16) float x1[LANES];
+  alignas(16) float y1[LANES];
+
+  void clear()
+  {
+    for (int i = 0; i < LANES; i++)
+      remove(i);
+  }
+
+  void set(int i, float left, float top, float right, float bottom)
+  {
+    x0[i] = left;
+    y0[i] = top;
+    x1[i] = right;
+    y1[i] = bottom;
+  }
+
+  // An inverted box fails every compare
+  void remove(int i) { set(i, FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX); }
+};
+
+template <int N>
+uint32_t overlapScalar(const AabbSoA<N> &boxes, float left, float top, float right, float bottom)
+{
+  uint32_t mask = 0;
+  for (int i = 0; i < AabbSoA<N>::LANES; i++)
+    if (left < boxes.x1[i] && right > boxes.x0[i] && top < boxes.y1[i] && bottom > boxes.y0[i])
+      mask |= 1u << i;
+  return mask;
+}
+
+template <int N>
+uint32_t overlapVector(const AabbSoA<N> &boxes, float left, float top, float right, float bottom)
+{
+  const aabb_f4 l = {left, left, left, left};
+  const aabb_f4 t = {top, top, top, top};
+  const aabb_f4 r = {right, right, right, right};
+  const aabb_f4 b = {bottom, bottom, bottom, bottom};
+
+  // Compares yield all-ones lanes; keep one distinct bit per lane and fold
+  const aabb_i4 bit = {1, 2, 4, 8};
+
+  uint32_t mask = 0;
+  for (int g = 0; g < AabbSoA<N>::LANES; g += AABB_GROUP)
+  {
+    const aabb_f4 &bx0 = *(const aabb_f4 *)(boxes.x0 + g);
+    const aabb_f4 &by0 = *(const aabb_f4 *)(boxes.y0 + g);
+    const aabb_f4 &bx1 = *(const aabb_f4 *)(boxes.x1 + g);
+    const aabb_f4 &by1 = *(const aabb_f4 *)(boxes.y1 + g);
+    aabb_i4 hit = (l < bx1) & (r > bx0) & (t < by1) & (b > by0) & bit;
+    uint32_t lanes = (hit[0] | hit[1]) | (hit[2] | hit[3]);
+    mask |= lanes << g;
+  }
+  return mask;
+}
+
+template <int N>
+inline uint32_t overlap(const AabbSoA<N> &boxes, float left, float top, float right, float bottom)
+{
+#ifdef __XTENSA__
+  return overlapScalar(boxes, left, top, right, bottom);
+#else
+  return overlapVector(boxes, left, top, right, bottom);
+#endif
+}
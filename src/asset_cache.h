@@ -0,0 +1,232 @@
+// ============================================================================
+// asset_cache.h - LRU cache of decompressed sprites
+// ============================================================================
+//
+// Compressed sprites are expanded on first use into one fixed-size arena
+// (PSRAM when the board has it) and stay there until space is needed.
+// Least recently used entries go first; pinned entries never leave.
+// Uncompressed sprites bypass the cache entirely.
+//
+// Background tiles do not go through here. A stage's tileset is a handful
+// of tiles that bg_stream.h loads whole into RAM once, and most of them are
+// on screen every frame, so a cache would only ever hit; compressing them
+// would save flash, not frame time.
+//
+// A SpriteInfo returned by get() stays valid until the next get() call,
+// which may evict or compact it. Pinned entries may move during
+// compaction, but the returned reference is updated in place. If a sprite
+// cannot be decoded the built-in art is returned, so draws never fail.
+
+#pragma once
+
+#include <Arduino.h>
+#include "assets.h"
+
+#ifndef ASSET_CACHE_SIZE
+#define ASSET_CACHE_SIZE (32 * 1024)
+#endif
+
+// Expands RLE565 tokens into out, returns false on malformed input
+static bool decodeRle565(const uint16_t *in, uint32_t inBytes, uint16_t *out, uint32_t outPixels)
+{
+  const uint16_t *end = in + inBytes / 2;
+  uint32_t n = 0;
+  while (in < end && n < outPixels)
+  {
+    uint16_t token = *in++;
+    uint32_t count = token & 0x7FFF;
+    if (count > outPixels - n)
+      return false;
+    if (token & 0x8000)
+    {
+      if (in >= end)
+        return false;
+      uint16_t px = *in++;
+      for (uint32_t i = 0; i < count; i++)
+        out[n++] = px;
+    }
+    else
+    {
+      if (end - in < (ptrdiff_t)count)
+        return false;
+      memcpy(out + n, in, count * 2);
+      in += count;
+      n += count;
+    }
+  }
+  return n == outPixels;
+}
+
+class AssetCache
+{
+private:
+  struct Slot
+  {
+    uint32_t offset;
+    uint32_t size;
+    uint32_t lastUse;
+    bool resident;
+    bool pinned;
+  };
+
+  uint8_t *arena = nullptr;
+  uint32_t arenaSize = 0;
+  uint32_t clock = 0;
+  Slot slots[SPRITE_COUNT];
+  SpriteInfo resolved[SPRITE_COUNT];
+
+public:
+  uint32_t hits = 0;
+  uint32_t misses = 0;
+  uint32_t evictions = 0;
+  uint32_t failures = 0;
+
+  bool begin(const AssetStore &source, uint32_t size = ASSET_CACHE_SIZE)
+  {
+    free(arena);
+#ifdef BOARD_HAS_PSRAM
+    arena = (uint8_t *)ps_malloc(size);
+#else
+    arena = (uint8_t *)malloc(size);
+#endif
+    arenaSize = arena ? size : 0;
+    clock = 0;
+    hits = misses = evictions = failures = 0;
+    for (int i = 0; i < SPRITE_COUNT; i++)
+    {
+      slots[i] = {0, 0, 0, false, false};
+      resolved[i] = source.sprite((SpriteId)i);
+    }
+    return arena != nullptr;
+  }
+
+  // Pinned sprites are decoded now and never evicted
+  void pin(SpriteId id)
+  {
+    slots[id].pinned = true;
+    get(id);
+  }
+
+  const SpriteInfo &get(SpriteId id)
+  {
+    SpriteInfo &info = resolved[id];
+    if (!info.packed)
+      return info;
+
+    Slot &slot = slots[id];
+    slot.lastUse = ++clock;
+    if (slot.resident)
+    {
+      hits++;
+      return info;
+    }
+
+    misses++;
+    uint32_t bytes = ((uint32_t)info.width * info.height * 2 + 3) & ~3u;
+    if (!makeRoom(bytes, id))
+    {
+      failures++;
+      return AssetStore::builtin(id);
+    }
+
+    uint16_t *dst = (uint16_t *)(arena + slot.offset);
+    if (!decodeRle565(info.packed, info.packedBytes, dst, (uint32_t)info.width * info.height))
+    {
+      failures++;
+      return AssetStore::builtin(id);
+    }
+    slot.size = bytes;
+    slot.resident = true;
+    info.pixels = dst;
+    return info;
+  }
+
+  uint32_t used() const
+  {
+    uint32_t total = 0;
+    for (int i = 0; i < SPRITE_COUNT; i++)
+      if (slots[i].resident)
+        total += slots[i].size;
+    return total;
+  }
+  uint32_t capacity() const { return arenaSize; }
+
+private:
+  // First gap of at least bytes between resident entries, or -1
+  int32_t findGap(uint32_t bytes)
+  {
+    uint32_t cursor = 0;
+    while (true)
+    {
+      // Lowest resident entry at or after the cursor
+      int next = -1;
+      for (int i = 0; i < SPRITE_COUNT; i++)
+        if (slots[i].resident && slots[i].offset >= cursor &&
+            (next < 0 || slots[i].offset < slots[next].offset))
+          next = i;
+      uint32_t gapEnd = next < 0 ? arenaSize : slots[next].offset;
+      if (gapEnd - cursor >= bytes)
+        return cursor;
+      if (next < 0)
+        return -1;
+      cursor = slots[next].offset + slots[next].size;
+    }
+  }
+
+  // Slides every resident entry down so all free space is at the end
+  void compact()
+  {
+    uint32_t cursor = 0;
+    while (true)
+    {
+      int next = -1;
+      for (int i = 0; i < SPRITE_COUNT; i++)
+        if (slots[i].resident && slots[i].offset >= cursor &&
+            (next < 0 || slots[i].offset < slots[next].offset))
+          next = i;
+      if (next < 0)
+        return;
+      Slot &s = slots[next];
+      if (s.offset != cursor)
+      {
+        memmove(arena + cursor, arena + s.offset, s.size);
+        s.offset = cursor;
+        resolved[next].pixels = (const uint16_t *)(arena + cursor);
+      }
+      cursor += s.size;
+    }
+  }
+
+  bool makeRoom(uint32_t bytes, SpriteId forId)
+  {
+    if (bytes > arenaSize)
+      return false;
+    while (true)
+    {
+      int32_t gap = findGap(bytes);
+      if (gap >= 0)
+      {
+        slots[forId].offset = gap;
+        return true;
+      }
+
+      // Enough free space in total but fragmented: compact instead of evicting
+      if (arenaSize - used() >= bytes)
+      {
+        compact();
+        continue;
+      }
+
+      int victim = -1;
+      for (int i = 0; i < SPRITE_COUNT; i++)
+        if (slots[i].resident && !slots[i].pinned && i != forId &&
+            (victim < 0 || slots[i].lastUse < slots[victim].lastUse))
+          victim = i;
+      if (victim < 0)
+        return false;
+      slots[victim].resident = false;
+      resolved[victim].pixels = nullptr;
+      evictions++;
+    }
+  }
+};
@@ -0,0 +1,236 @@
+// ============================================================================
+// assets.h - Sprite lookup from a memory-mapped asset bundle
+// ============================================================================
+//
+// Sprites are addressed by SpriteId. At boot the "assets" flash partition
+// is mapped into the address space and, if it holds a valid bundle, every
+// sprite points straight into mapped flash - nothing is copied. Without a
+// bundle the PROGMEM arrays from grafx.h are used, so a board flashed with
+// firmware only still runs.
+//
+// Bundle layout (little endian, built by tools/build_assets.py):
+//
+//   AssetBundleHeader
+//   AssetEntry[count]      entry i describes SpriteId i, O(1) lookup
+//   pixel data             RGB565 or RLE, each sprite 4-byte aligned
+//
+// RLE data is a stream of 16-bit tokens: 0x8000 | n followed by one pixel
+// repeated n times, or n followed by n literal pixels. Compressed sprites
+// are expanded on demand by AssetCache (asset_cache.h).
+//
+// Flash a bundle with:  esptool.py write_flash 0x310000 assets.bin
+//
+// Animated sprites are sheets: equal-sized cells stacked top to bottom in
+// one sprite. AnimClip entries below name a sheet and the cells to show.
+
+#pragma once
+
+#include <Arduino.h>
+#include "grafx.h"
+
+#ifdef ARDUINO
+#include <esp_partition.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Keep in sync with SPRITES in tools/build_assets.py
+enum SpriteId
+{
+  SPRITE_PLAYER,
+  SPRITE_ENEMY_BASIC,
+  SPRITE_ENEMY_FAST,
+  SPRITE_ENEMY_TANK,
+  SPRITE_BULLET_PLAYER,
+  SPRITE_BULLET_ENEMY,
+  SPRITE_POWERUP_HEALTH,
+  SPRITE_POWERUP_WEAPON,
+  SPRITE_EXPLOSION,
+  SPRITE_COUNT
+};
+
+#define ASSET_MAGIC 0x42415353 // "SSAB"
+#define ASSET_VERSION 1
+#define ASSET_FORMAT_RGB565 0
+#define ASSET_FORMAT_RLE565 1
+
+struct AssetBundleHeader
+{
+  uint32_t magic;
+  uint16_t version;
+  uint16_t count;
+  uint32_t totalSize;
+};
+
+struct AssetEntry
+{
+  uint16_t width;
+  uint16_t height;
+  uint8_t format;
+  uint8_t flags;
+  uint16_t reserved;
+  uint32_t offset; // from the start of the bundle
+  uint32_t size;
+};
+
+struct SpriteInfo
+{
+  uint16_t width;
+  uint16_t height;
+  const uint16_t *pixels; // nullptr while only the packed form is at hand
+  uint8_t format;
+  const uint16_t *packed;
+  uint32_t packedBytes;
+};
+
+class AssetStore
+{
+private:
+  SpriteInfo sprites[SPRITE_COUNT];
+  const uint8_t *bundle = nullptr;
+  size_t bundleSize = 0;
+
+#ifdef ARDUINO
+  spi_flash_mmap_handle_t mapHandle;
+#endif
+
+  void useBuiltins()
+  {
+    for (int i = 0; i < SPRITE_COUNT; i++)
+      sprites[i] = builtin((SpriteId)i);
+  }
+
+public:
+  // The art compiled into the firmware image
+  static const SpriteInfo &builtin(SpriteId id)
+  {
+    static const SpriteInfo table[SPRITE_COUNT] = {
+        {24, 24, player_ship_map, ASSET_FORMAT_RGB565, nullptr, 0},
+        {20, 20, enemy_basic_map, ASSET_FORMAT_RGB565, nullptr, 0},
+        {16, 16, enemy_fast_map, ASSET_FORMAT_RGB565, nullptr, 0},
+        {28, 28, enemy_tank_map, ASSET_FORMAT_RGB565, nullptr, 0},
+        {4, 8, bullet_player_map, ASSET_FORMAT_RGB565, nullptr, 0},
+        {4, 8, bullet_enemy_map, ASSET_FORMAT_RGB565, nullptr, 0},
+        {16, 16, powerup_health_map, ASSET_FORMAT_RGB565, nullptr, 0},
+        {16, 16, powerup_weapon_map, ASSET_FORMAT_RGB565, nullptr, 0},
+        {24, 144, explosion_map, ASSET_FORMAT_RGB565, nullptr, 0},
+    };
+    return table[id];
+  }
+
+  // Validates a bundle at any address and points sprites into it. Entries
+  // the bundle lacks or cannot describe keep their built-in art, as do
+  // entries whose size differs from it, since entity
+  // archetypes and their clipping are sized to match it.
+  bool attach(const void *base, size_t size)
+  {
+    useBuiltins();
+    const AssetBundleHeader *hdr = (const AssetBundleHeader *)base;
+    if (!base || size < sizeof(AssetBundleHeader) || hdr->magic != ASSET_MAGIC ||
+        hdr->version != ASSET_VERSION || hdr->totalSize > size ||
+        sizeof(AssetBundleHeader) + hdr->count * sizeof(AssetEntry) > hdr->totalSize)
+      return false;
+
+    const AssetEntry *index = (const AssetEntry *)(hdr + 1);
+    int n = min((int)hdr->count, (int)SPRITE_COUNT);
+    for (int i = 0; i < n; i++)
+    {
+      const AssetEntry &e = index[i];
+      const SpriteInfo &art = builtin((SpriteId)i);
+      if ((e.offset & 3) || e.offset > hdr->totalSize || e.size > hdr->totalSize - e.offset ||
+          e.width != art.width || e.height != art.height)
+        continue;
+      const uint16_t *data = (const uint16_t *)((const uint8_t *)base + e.offset);
+      if (e.format == ASSET_FORMAT_RGB565 && e.size >= (uint32_t)e.width * e.height * 2)
+        sprites[i] = {e.width, e.height, data, ASSET_FORMAT_RGB565, nullptr, 0};
+      else if (e.format == ASSET_FORMAT_RLE565)
+        sprites[i] = {e.width, e.height, nullptr, ASSET_FORMAT_RLE565, data, e.size};
+    }
+    bundle = (const uint8_t *)base;
+    bundleSize = hdr->totalSize;
+    return true;
+  }
+
+  bool begin()
+  {
+    useBuiltins();
+#ifdef ARDUINO
+    const esp_partition_t *part = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, "assets");
+    if (!part)
+      return false;
+    const void *ptr;
+    if (esp_partition_mmap(part, 0, part->size, SPI_FLASH_MMAP_DATA, &ptr, &mapHandle) != ESP_OK)
+      return false;
+    if (attach(ptr, part->size))
+      return true;
+    spi_flash_munmap(mapHandle);
+    return false;
+#else
+    // Host builds map the same bundle file read-only
+    const char *path = getenv("ASSET_BUNDLE");
+    int fd = path ? open(path, O_RDONLY) : -1;
+    if (fd < 0)
+      return false;
+    struct stat st;
+    void *ptr = fstat(fd, &st) == 0 ? mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (ptr == MAP_FAILED)
+      return false;
+    if (attach(ptr, st.st_size))
+      return true;
+    munmap(ptr, st.st_size);
+    return false;
+#endif
+  }
+
+  const SpriteInfo &sprite(SpriteId id) const { return sprites[id]; }
+  bool mapped() const { return bundle != nullptr; }
+  size_t mappedSize() const { return bundleSize; }
+};
+
+// ---- Animation clips -------------------------------------------------------
+
+#define ANIM_ONCE 0     // stop on the last frame
+#define ANIM_LOOP 1     // wrap to the first frame
+#define ANIM_PINGPONG 2 // run back and forth
+
+enum AnimClipId
+{
+  CLIP_EXPLOSION,
+  CLIP_COUNT,
+  CLIP_NONE = 0xFF
+};
+
+// One step of a clip: which sheet cell to show and for how many ticks
+struct AnimFrame
+{
+  uint8_t cell;
+  uint8_t ticks;
+};
+
+struct AnimClip
+{
+  SpriteId sheet;
+  uint8_t cellHeight;
+  uint8_t loop;
+  uint8_t frameCount;
+  const AnimFrame *frames;
+};
+
+const AnimFrame explosion_frames[] = {{0, 2}, {1, 2}, {2, 2}, {3, 2}, {4, 2}, {5, 2}};
+
+const AnimClip animClips[CLIP_COUNT] = {
+    {SPRITE_EXPLOSION, 24, ANIM_ONCE, 6, explosion_frames},
+};
+
+// Pixels of one sheet cell, or nullptr if the sheet is not decoded
+inline const uint16_t *sheetCell(const SpriteInfo &sheet, const AnimClip &clip, int frame)
+{
+  if (!sheet.pixels)
+    return nullptr;
+  return sheet.pixels + (size_t)clip.frames[frame].cell * sheet.width * clip.cellHeight;
+}
@@ -0,0 +1,321 @@
+// ============================================================================
+// bg_stream.h - Streamed tile-map background for long scrolling stages
+// ============================================================================
+//
+// A stage is a tileset plus a tall map of tile rows. Only the tileset is
+// held in RAM; map rows are read by a background task a little ahead of
+// the scroll position and handed to the game loop through an SPSC ring.
+// A row the game needs before it has arrived counts as a stall. Tiles are
+// stored uncompressed; see asset_cache.h for why they are not cached.
+//
+// Stage file layout (little endian, built by tools/build_stage.py):
+//
+//   StageHeader
+//   tileset                tileCount * tileSize * tileSize RGB565 pixels
+//   map                    rows * columns tile indices, row 0 shown first
+//
+// Row 0 is the bottom of the stage; the stage loops when it runs out.
+
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include "ring_buffer.h"
+
+#ifdef ARDUINO
+#include <esp_partition.h>
+#include <FS.h>
+#else
+#include <stdio.h>
+#endif
+
+#define STAGE_MAGIC 0x47545353 // "SSTG"
+#define STAGE_VERSION 1
+#define STAGE_MAX_COLUMNS 16
+
+// Seconds of scrolling, in frames, that the streamer tries to stay ahead
+#ifndef STREAM_PREFETCH_FRAMES
+#define STREAM_PREFETCH_FRAMES 30
+#endif
+
+struct StageHeader
+{
+  uint32_t magic;
+  uint16_t version;
+  uint8_t tileSize;
+  uint8_t columns;
+  uint32_t rows;
+  uint16_t tileCount;
+  uint16_t reserved;
+};
+
+// ---- Sources ---------------------------------------------------------------
+
+class StageSource
+{
+public:
+  virtual ~StageSource() {}
+  virtual bool read(uint32_t offset, void *dst, size_t len) = 0;
+};
+
+#ifdef ARDUINO
+// Raw reads from a flash partition (the "stage" partition by default)
+class PartitionStageSource : public StageSource
+{
+private:
+  const esp_partition_t *part = nullptr;
+
+public:
+  bool open(const char *label = "stage")
+  {
+    part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    return part != nullptr;
+  }
+
+  bool read(uint32_t offset, void *dst, size_t len) override
+  {
+    return part && esp_partition_read(part, offset, dst, len) == ESP_OK;
+  }
+};
+
+// Any Arduino filesystem, e.g. SD.open("/stage.bin")
+class FileStageSource : public StageSource
+{
+private:
+  fs::File file;
+
+public:
+  explicit FileStageSource(fs::File f) : file(f) {}
+
+  bool read(uint32_t offset, void *dst, size_t len) override
+  {
+    return file && file.seek(offset) && file.read((uint8_t *)dst, len) == len;
+  }
+};
+#else
+class FileStageSource : public StageSource
+{
+private:
+  FILE *file;
+
+public:
+  explicit FileStageSource(const char *path) : file(fopen(path, "rb")) {}
+  ~FileStageSource() override
+  {
+    if (file)
+      fclose(file);
+  }
+
+  bool read(uint32_t offset, void *dst, size_t len) override
+  {
+    return file && fseek(file, offset, SEEK_SET) == 0 && fread(dst, 1, len, file) == len;
+  }
+};
+#endif
+
+// Wraps another source and slows every read down, to check that the
+// prefetch distance covers slow media
+class ThrottledStageSource : public StageSource
+{
+private:
+  StageSource &inner;
+  uint32_t delayUs;
+
+public:
+  ThrottledStageSource(StageSource &src, uint32_t usPerRead) : inner(src), delayUs(usPerRead) {}
+
+  bool read(uint32_t offset, void *dst, size_t len) override
+  {
+    delayMicroseconds(delayUs);
+    return inner.read(offset, dst, len);
+  }
+};
+
+// ---- Streamer --------------------------------------------------------------
+
+class BackgroundStreamer
+{
+public:
+  struct MapRow
+  {
+    uint32_t index;
+    uint32_t generation; // seek() the row was read for
+    uint8_t tiles[STAGE_MAX_COLUMNS];
+  };
+
+private:
+  // Rows the game loop keeps for drawing: the screen plus a little slack
+  static const int WINDOW = 32;
+
+  StageSource *source = nullptr;
+  StageHeader header;
+  int viewHeight = 0;
+  uint16_t *tileset = nullptr;
+  uint32_t mapOffset = 0;
+
+  SpscRing<MapRow, 64> ring;
+  std::atomic<uint32_t> wantedRow;  // producer reads up to this row
+  std::atomic<uint32_t> seekRow;    // where the latest seek() restarts reading
+  std::atomic<uint32_t> generation; // bumped by seek(), after seekRow
+  uint32_t nextRead = 0;            // producer-owned
+  uint32_t readGeneration = 0;      // producer-owned
+  uint32_t nextPop = 0;             // consumer-owned
+  MapRow window[WINDOW];
+  bool present[WINDOW];
+  bool inlineReads = false;
+
+#ifdef ARDUINO
+  TaskHandle_t task = nullptr;
+
+  static void taskMain(void *arg)
+  {
+    BackgroundStreamer *self = (BackgroundStreamer *)arg;
+    while (true)
+    {
+      self->produce();
+      vTaskDelay(1);
+    }
+  }
+#endif
+
+public:
+  // Written by one side, readable from either
+  std::atomic<uint32_t> stalls;     // consumer
+  std::atomic<uint32_t> readErrors; // producer
+
+  BackgroundStreamer() : wantedRow(0), seekRow(0), generation(0), stalls(0), readErrors(0) {}
+
+  // Loads the header and tileset, then starts the reader task. Without
+  // a task (host builds) advance() reads the rows itself. Pass
+  // ownReader = false to call produce() from a thread of your own.
+  // Stages whose tiles cannot cover the screen, or need more rows on
+  // screen than the window holds, are rejected.
+  bool begin(StageSource *src, int screenWidth, int screenHeight, bool ownReader = true)
+  {
+    source = src;
+    viewHeight = screenHeight;
+    if (!src->read(0, &header, sizeof(header)) || header.magic != STAGE_MAGIC ||
+        header.version != STAGE_VERSION || header.columns == 0 ||
+        header.columns > STAGE_MAX_COLUMNS || header.rows == 0 || header.tileCount == 0 ||
+        header.tileSize == 0 || header.columns * header.tileSize < screenWidth || visibleRows() + 1 > WINDOW)
+      return false;
+
+    size_t tileBytes = (size_t)header.tileSize * header.tileSize * 2;
+#ifdef BOARD_HAS_PSRAM
+    tileset = (uint16_t *)ps_malloc(tileBytes * header.tileCount);
+#else
+    tileset = (uint16_t *)malloc(tileBytes * header.tileCount);
+#endif
+    if (!tileset || !src->read(sizeof(header), tileset, tileBytes * header.tileCount))
+    {
+      free(tileset);
+      tileset = nullptr;
+      return false;
+    }
+    mapOffset = sizeof(header) + tileBytes * header.tileCount;
+
+    for (int i = 0; i < WINDOW; i++)
+      present[i] = false;
+    // The first screen is read up front so the stage starts without stalls
+    wantedRow.store(visibleRows() + 1);
+    produce();
+
+#ifdef ARDUINO
+    if (ownReader && xTaskCreatePinnedToCore(taskMain, "bgstream", 3072, this, 1, &task, 0) == pdPASS)
+      return true;
+#endif
+    inlineReads = ownReader;
+    return true;
+  }
+
+  bool active() const { return tileset != nullptr; }
+  uint8_t tileSize() const { return header.tileSize; }
+  uint8_t columns() const { return header.columns; }
+  int visibleRows() const { return viewHeight / header.tileSize + 1; }
+
+  const uint16_t *tile(uint8_t index) const
+  {
+    if (index >= header.tileCount)
+      index = 0;
+    return tileset + (size_t)index * header.tileSize * header.tileSize;
+  }
+
+  // Producer: reads rows until it is prefetch rows ahead or the ring is
+  // full. Runs in the reader task, or inline from advance().
+  void produce()
+  {
+    uint32_t gen = generation.load(std::memory_order_acquire);
+    if (gen != readGeneration)
+    {
+      readGeneration = gen;
+      nextRead = seekRow.load(std::memory_order_relaxed);
+    }
+    uint32_t target = wantedRow.load(std::memory_order_acquire);
+    while ((int32_t)(target - nextRead) > 0)
+    {
+      if (ring.size() >= ring.capacity())
+        return;
+      MapRow row;
+      row.index = nextRead;
+      row.generation = readGeneration;
+      uint32_t stageRow = nextRead % header.rows;
+      if (!source->read(mapOffset + stageRow * header.columns, row.tiles, header.columns))
+      {
+        readErrors.fetch_add(1, std::memory_order_relaxed);
+        memset(row.tiles, 0, sizeof(row.tiles));
+      }
+      ring.push(row);
+      nextRead++;
+    }
+  }
+
+  // Consumer, once per frame: asks for rows ahead of the scroll position
+  // and collects whatever has arrived for the visible window.
+  void advance(float stageY, float speedPxPerFrame)
+  {
+    uint32_t first = (uint32_t)stageY / header.tileSize;
+    uint32_t last = first + visibleRows();
+    uint32_t prefetch = (uint32_t)ceilf(speedPxPerFrame * STREAM_PREFETCH_FRAMES / header.tileSize) + 1;
+    wantedRow.store(last + prefetch, std::memory_order_release);
+    if (inlineReads)
+      produce();
+
+    MapRow row;
+    uint32_t gen = generation.load(std::memory_order_relaxed);
+    while ((int32_t)(last - nextPop) >= 0 && ring.pop(row))
+    {
+      if (row.generation != gen)
+        continue;
+      nextPop = row.index + 1;
+      window[row.index % WINDOW] = row;
+      present[row.index % WINDOW] = true;
+    }
+    for (uint32_t r = first; r <= last; r++)
+      if (!present[r % WINDOW] || window[r % WINDOW].index != r)
+        stalls.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Consumer: moves the stream to a new scroll position, e.g. a new run or
+  // a restored snapshot. Rows already in flight are dropped as they come
+  // out of the ring; the producer restarts reading at the new row. With a
+  // reader task the first frame after a seek may still stall.
+  void seek(float stageY)
+  {
+    uint32_t first = (uint32_t)stageY / header.tileSize;
+    nextPop = first;
+    for (int i = 0; i < WINDOW; i++)
+      present[i] = false;
+    seekRow.store(first, std::memory_order_relaxed);
+    generation.fetch_add(1, std::memory_order_release);
+    wantedRow.store(first + visibleRows() + 1, std::memory_order_release);
+    if (inlineReads)
+      produce();
+  }
+
+  // Map row r, or nullptr if it has not streamed in yet
+  const uint8_t *row(uint32_t r) const
+  {
+    const MapRow &m = window[r % WINDOW];
+    return present[r % WINDOW] && m.index == r ? m.tiles : nullptr;
+  }
+};
@@ -0,0 +1,127 @@
+// ============================================================================
+// blit.h - Sprite blits with colour transform and mirroring
+// ============================================================================
+//
+// Writes straight into a 16-bit LGFX_Sprite buffer, so one copy of the art
+// can be drawn flashed, tinted, darkened or flipped without keeping extra
+// versions of it. Colour changes go through ColorLut, one small table per
+// channel (128 bytes in all), built once and reused.
+//
+// The sprite buffer holds RGB565 byte-swapped (panel order) while the art
+// is native RGB565, so every pixel is swapped on the way in - the same
+// thing pushImage() does. Black is the art's background and is written
+// unchanged by every transform.
+
+#pragma once
+
+#include <Arduino.h>
+#include <LovyanGFX.hpp>
+
+#define BLIT_MIRROR_X 0x01
+#define BLIT_MIRROR_Y 0x02
+
+struct ColorLut
+{
+  uint8_t r[32];
+  uint8_t g[64];
+  uint8_t b[32];
+
+  // Blends every channel towards target, amount 0 (none) .. 255 (all)
+  void toward(uint16_t target, uint8_t amount)
+  {
+    uint8_t tr = target >> 11, tg = (target >> 5) & 0x3F, tb = target & 0x1F;
+    for (int i = 0; i < 32; i++)
+    {
+      r[i] = i + ((tr - i) * amount) / 255;
+      b[i] = i + ((tb - i) * amount) / 255;
+    }
+    for (int i = 0; i < 64; i++)
+      g[i] = i + ((tg - i) * amount) / 255;
+  }
+
+  // Scales every channel, 256 = unchanged
+  void scale(uint16_t factor)
+  {
+    for (int i = 0; i < 32; i++)
+    {
+      r[i] = min(31, (i * factor) >> 8);
+      b[i] = min(31, (i * factor) >> 8);
+    }
+    for (int i = 0; i < 64; i++)
+      g[i] = min(63, (i * factor) >> 8);
+  }
+
+  uint16_t apply(uint16_t c) const
+  {
+    return (r[c >> 11] << 11) | (g[(c >> 5) & 0x3F] << 5) | b[c & 0x1F];
+  }
+};
+
+static inline uint16_t swap565(uint16_t c)
+{
+  return (c >> 8) | (c << 8);
+}
+
+// Draws a w x h native RGB565 image at x, y, clipped to the sprite.
+// Returns the number of pixels written. Falls back to pushImage() when the
+// sprite has no buffer, which only supports the untransformed case.
+static uint32_t blitImage(LGFX_Sprite &dst, int x, int y, int w, int h, const uint16_t *src,
+                          uint8_t flags = 0, const ColorLut *lut = nullptr)
+{
+  uint16_t *buf = (uint16_t *)dst.getBuffer();
+  if (!buf)
+  {
+    dst.pushImage(x, y, w, h, src);
+    return (uint32_t)w * h;
+  }
+
+  int dw = dst.width(), dh = dst.height();
+  int x0 = max(x, 0), x1 = min(x + w, dw);
+  int y0 = max(y, 0), y1 = min(y + h, dh);
+  if (x0 >= x1 || y0 >= y1)
+    return 0;
+
+  bool flipX = flags & BLIT_MIRROR_X;
+  bool flipY = flags & BLIT_MIRROR_Y;
+  int step = flipX ? -1 : 1;
+  int span = x1 - x0;
+
+  for (int dy = y0; dy < y1; dy++)
+  {
+    int sy = flipY ? h - 1 - (dy - y) : dy - y;
+    int sx = flipX ? w - 1 - (x0 - x) : x0 - x;
+    const uint16_t *in = src + sy * w + sx;
+    uint16_t *out = buf + dy * dw + x0;
+    if (lut)
+    {
+      for (int i = 0; i < span; i++, in += step)
+      {
+        uint16_t c = *in;
+        *out++ = c ? swap565(lut->apply(c)) : 0;
+      }
+    }
+    else
+    {
+      for (int i = 0; i < span; i++, in += step)
+        *out++ = swap565(*in);
+    }
+  }
+  return (uint32_t)span * (y1 - y0);
+}
+
+// Straight copy for an image known to lie entirely inside the sprite: no
+// clipping, no transform. Callers classify first (see Game::classify).
+static void blitUnclipped(LGFX_Sprite &dst, int x, int y, int w, int h, const uint16_t *src)
+{
+  uint16_t *buf = (uint16_t *)dst.getBuffer();
+  if (!buf)
+  {
+    dst.pushImage(x, y, w, h, src);
+    return;
+  }
+  int dw = dst.width();
+  uint16_t *out = buf + y * dw + x;
+  for (int row = 0; row < h; row++, out += dw)
+    for (int i = 0; i < w; i++)
+      out[i] = swap565(*src++);
+}
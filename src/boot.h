@@ -0,0 +1,124 @@
+// ============================================================================
+// boot.h - Boot phase timing and deferred initialisation
+// ============================================================================
+//
+// BootTrace keeps a timestamp at the end of each named boot phase, in
+// micros() since the app started, and prints them as a table once boot is
+// over.
+//
+// DeferredInit holds the setup steps the first frame does not need. loop()
+// runs them a few at a time between frames while the title screen is up,
+// and finish() runs whatever is left at once when something needs them
+// all, e.g. a run about to start. Each step's own time is kept, since the
+// gaps between them are frames, not boot.
+
+#pragma once
+
+#include <Arduino.h>
+
+#define BOOT_MAX_PHASES 24
+
+class BootTrace
+{
+private:
+  struct Phase
+  {
+    const char *name;
+    uint32_t endUs;
+  };
+
+  Phase phases[BOOT_MAX_PHASES];
+  int count = 0;
+
+public:
+  // Ends the phase called name now
+  void mark(const char *name)
+  {
+    if (count < BOOT_MAX_PHASES)
+      phases[count++] = {name, (uint32_t)micros()};
+  }
+
+  // When the phase called name ended, 0 if it has not
+  uint32_t at(const char *name) const
+  {
+    for (int i = 0; i < count; i++)
+      if (strcmp(phases[i].name, name) == 0)
+        return phases[i].endUs;
+    return 0;
+  }
+
+  void print() const
+  {
+    uint32_t prev = 0;
+    for (int i = 0; i < count; i++)
+    {
+      Serial.printf("BOOT %-14s %7.1f ms  (+%.1f)\n", phases[i].name, phases[i].endUs / 1000.0f,
+                    (phases[i].endUs - prev) / 1000.0f);
+      prev = phases[i].endUs;
+    }
+  }
+};
+
+struct DeferredStep
+{
+  const char *name;
+  void (*run)();
+};
+
+class DeferredInit
+{
+private:
+  const DeferredStep *steps = nullptr;
+  int count = 0;
+  int next = 0;
+  uint32_t took[BOOT_MAX_PHASES];
+
+  void runNext()
+  {
+    uint32_t t0 = micros();
+    steps[next].run();
+    uint32_t us = micros() - t0;
+    if (next < BOOT_MAX_PHASES)
+      took[next] = us;
+    totalUs += us;
+    next++;
+  }
+
+public:
+  uint32_t totalUs = 0; // time the steps took between them
+
+  void begin(const DeferredStep *table, int n)
+  {
+    steps = table;
+    count = n;
+    next = 0;
+    totalUs = 0;
+  }
+
+  bool done() const { return next >= count; }
+
+  // Runs steps until budgetUs is used up, at least one while any are left.
+  // Returns true when that finished the last of them.
+  bool step(uint32_t budgetUs)
+  {
+    if (done())
+      return false;
+    uint32_t t0 = micros();
+    do
+      runNext();
+    while (!done() && micros() - t0 < budgetUs);
+    return done();
+  }
+
+  void finish()
+  {
+    while (!done())
+      runNext();
+  }
+
+  void print() const
+  {
+    for (int i = 0; i < next && i < BOOT_MAX_PHASES; i++)
+      Serial.printf("BOOT deferred %-14s %5.1f ms\n", steps[i].name, took[i] / 1000.0f);
+  }
+};
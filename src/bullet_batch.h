@@ -0,0 +1,153 @@
+// ============================================================================
+// bullet_batch.h - Batched bullet drawing from precomputed row spans
+// ============================================================================
+//
+// Bullets are tiny, so one pushImage() each is almost all call overhead.
+// BulletBatch turns a bullet sprite once into runs of opaque pixels per
+// row, already byte-swapped for the canvas, then draws every queued
+// bullet of that kind in one pass straight into the canvas buffer. Black
+// pixels are the art's background and are left out of the spans, so
+// bullets overlap cleanly instead of drawing their bounding box.
+
+#pragma once
+
+#include <Arduino.h>
+#include <LovyanGFX.hpp>
+#include "assets.h"
+#include "blit.h"
+
+// N is the most bullets one batch can queue per frame
+template <int N>
+class BulletBatch
+{
+private:
+  static const int MAX_SPANS = 32;
+  static const int MAX_PIXELS = 128;
+
+  struct Span
+  {
+    uint8_t dy;
+    uint8_t dx;
+    uint8_t len;
+    uint8_t offset; // into pixels[]
+  };
+
+  Span spans[MAX_SPANS];
+  uint16_t pixels[MAX_PIXELS];
+  int spanCount = 0;
+  int width = 0;
+  int height = 0;
+
+  int16_t xs[N];
+  int16_t ys[N];
+  int queued = 0;
+
+public:
+  // Splits each row of the sprite into opaque runs. Sprites too big for
+  // the span table keep working through pushImage().
+  bool build(const SpriteInfo &s)
+  {
+    spanCount = 0;
+    width = s.width;
+    height = s.height;
+    if (!s.pixels || s.width > 255 || s.height > 255)
+      return false;
+
+    int used = 0;
+    for (int y = 0; y < s.height; y++)
+    {
+      int x = 0;
+      while (x < s.width)
+      {
+        if (!s.pixels[y * s.width + x])
+        {
+          x++;
+          continue;
+        }
+        int start = x;
+        while (x < s.width && s.pixels[y * s.width + x])
+          x++;
+        if (spanCount == MAX_SPANS || used + (x - start) > MAX_PIXELS)
+        {
+          spanCount = 0;
+          return false;
+        }
+        spans[spanCount++] = {(uint8_t)y, (uint8_t)start, (uint8_t)(x - start), (uint8_t)used};
+        for (int i = start; i < x; i++)
+          pixels[used++] = swap565(s.pixels[y * s.width + i]);
+      }
+    }
+    return true;
+  }
+
+  void clear() { queued = 0; }
+
+  // Queues a bullet by its top-left corner, false when the batch is full
+  bool add(int x, int y)
+  {
+    if (queued == N)
+      return false;
+    xs[queued] = x;
+    ys[queued] = y;
+    queued++;
+    return true;
+  }
+
+  int size() const { return queued; }
+
+  // Pixels one bullet writes when fully on screen
+  int opaquePixels() const
+  {
+    if (!spanCount)
+      return width * height;
+    int n = 0;
+    for (int s = 0; s < spanCount; s++)
+      n += spans[s].len;
+    return n;
+  }
+
+  // Draws everything queued since clear(), returns pixels written. art is
+  // the sprite build() saw, used only when spans cannot be.
+  uint32_t draw(LGFX_Sprite &dst, const uint16_t *art)
+  {
+    uint16_t *buf = (uint16_t *)dst.getBuffer();
+    if (!buf || !spanCount)
+    {
+      for (int i = 0; i < queued; i++)
+        dst.pushImage(xs[i], ys[i], width, height, art);
+      return (uint32_t)queued * width * height;
+    }
+
+    int dw = dst.width(), dh = dst.height();
+    uint32_t written = 0;
+    for (int i = 0; i < queued; i++)
+    {
+      int x = xs[i], y = ys[i];
+      if (x >= 0 && y >= 0 && x + width <= dw && y + height <= dh)
+      {
+        uint16_t *base = buf + y * dw + x;
+        for (int s = 0; s < spanCount; s++)
+        {
+          const Span &sp = spans[s];
+          memcpy(base + sp.dy * dw + sp.dx, pixels + sp.offset, sp.len * 2);
+          written += sp.len;
+        }
+        continue;
+      }
+
+      // Straddles an edge: clip each span
+      for (int s = 0; s < spanCount; s++)
+      {
+        const Span &sp = spans[s];
+        int py = y + sp.dy;
+        int x0 = max(x + sp.dx, 0);
+        int x1 = min(x + sp.dx + sp.len, dw);
+        if (py < 0 || py >= dh || x0 >= x1)
+          continue;
+        memcpy(buf + py * dw + x0, pixels + sp.offset + (x0 - x - sp.dx), (x1 - x0) * 2);
+        written += x1 - x0;
+      }
+    }
+    return written;
+  }
+};
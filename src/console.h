@@ -0,0 +1,149 @@
+// ============================================================================
+// console.h - Line-based command console over Serial
+// ============================================================================
+//
+// poll() is called once per frame with a time budget. It sends queued
+// output while the UART has room, then reads whatever input has arrived
+// into a fixed line buffer. A complete line is split into words in place
+// and handed to the matching ConsoleCommand - at most one per poll, so a
+// burst of pasted commands spreads over several frames.
+//
+// Nothing here allocates: the line is a fixed array, replies are
+// formatted on the stack and queued in a ring, and a reply that does not
+// fit is dropped (and counted) rather than waited on.
+
+#pragma once
+
+#include <Arduino.h>
+#include <stdarg.h>
+#include "ring_buffer.h"
+
+#define CONSOLE_LINE 64
+#define CONSOLE_ARGS 8
+#define CONSOLE_OUT_BYTES 1024
+#define CONSOLE_REPLY 96 // longest formatted reply line
+
+struct ConsoleCommand
+{
+  const char *name;
+  const char *usage; // arguments and what it does, for help
+  void (*run)(int argc, char **argv);
+};
+
+class SerialConsole
+{
+private:
+  const ConsoleCommand *commands = nullptr;
+  int commandCount = 0;
+  char line[CONSOLE_LINE + 1];
+  uint8_t length = 0;
+  bool tooLong = false;
+  SpscRing<char, CONSOLE_OUT_BYTES> out;
+
+  void execute()
+  {
+    char *argv[CONSOLE_ARGS];
+    int argc = 0;
+    char *p = line;
+    while (*p && argc < CONSOLE_ARGS)
+    {
+      while (*p == ' ' || *p == '\t')
+        *p++ = 0;
+      if (!*p)
+        break;
+      argv[argc++] = p;
+      while (*p && *p != ' ' && *p != '\t')
+        p++;
+    }
+    if (!argc)
+      return;
+
+    if (strcmp(argv[0], "help") == 0)
+    {
+      for (int i = 0; i < commandCount; i++)
+        printf("%-8s %s\n", commands[i].name, commands[i].usage);
+      return;
+    }
+    for (int i = 0; i < commandCount; i++)
+      if (strcmp(argv[0], commands[i].name) == 0)
+      {
+        commands[i].run(argc, argv);
+        return;
+      }
+    printf("unknown command '%s', try help\n", argv[0]);
+  }
+
+public:
+  uint32_t dropped = 0; // reply bytes that did not fit the queue
+  uint32_t lastUs = 0;  // time spent by the last poll()
+  uint32_t maxUs = 0;
+
+  void begin(const ConsoleCommand *table, int count)
+  {
+    commands = table;
+    commandCount = count;
+  }
+
+  // Queues a reply; the whole line is dropped if the queue is too full
+  void printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)))
+  {
+    char buf[CONSOLE_REPLY];
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    if (n <= 0)
+      return;
+    n = min(n, (int)sizeof(buf) - 1);
+    if (out.capacity() - out.size() < (size_t)n)
+    {
+      dropped += n;
+      return;
+    }
+    out.pushBatch(buf, n);
+  }
+
+  // One input character. Returns true when it completed a command line.
+  bool feed(char c)
+  {
+    if (c == '\r' || c == '\n')
+    {
+      bool run = length > 0 && !tooLong;
+      if (tooLong)
+        printf("line too long, %d characters at most\n", CONSOLE_LINE);
+      line[length] = 0;
+      if (run)
+        execute();
+      length = 0;
+      tooLong = false;
+      return run;
+    }
+    if (c == '\b' || c == 0x7F)
+    {
+      if (length)
+        length--;
+    }
+    else if (length < CONSOLE_LINE)
+      line[length++] = c;
+    else
+      tooLong = true;
+    return false;
+  }
+
+  void poll(uint32_t budgetUs)
+  {
+    uint32_t t0 = micros();
+    char chunk[32];
+    int room;
+    while ((room = Serial.availableForWrite()) > 0 && out.size() && micros() - t0 < budgetUs)
+    {
+      size_t n = out.popBatch(chunk, min((size_t)room, sizeof(chunk)));
+      Serial.write((const uint8_t *)chunk, n);
+    }
+    while (Serial.available() > 0 && micros() - t0 < budgetUs)
+      if (feed((char)Serial.read()))
+        break;
+    lastUs = micros() - t0;
+    maxUs = max(maxUs, lastUs);
+  }
+};
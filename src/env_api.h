@@ -0,0 +1,91 @@
+// ============================================================================
+// env_api.h - Headless game environments for automated players
+// ============================================================================
+//
+// A batch of independent games, each with its own clock, input and seed,
+// stepped together with one action per game. Nothing is drawn and nothing
+// is heard; observations are written into buffers the caller owns, laid
+// out one environment after another, so a trainer can hand them straight
+// to its own arrays. Stepping and observing never allocate.
+//
+// A game that ends is restarted on the next seed within the same step,
+// with its done flag set, so the batch always holds live games.
+//
+// Plain C so it can be called from anything with a C FFI. The games are
+// implemented in main.cpp (ENVIRONMENTS).
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ENV_MAX_OBJECTS 64
+
+// envRender() cell grid: one byte per 4x4 screen pixels
+#define ENV_FRAME_SCALE 4
+#define ENV_FRAME_WIDTH (320 / ENV_FRAME_SCALE)
+#define ENV_FRAME_HEIGHT (480 / ENV_FRAME_SCALE)
+
+#define ENV_FIRE 0x01
+
+typedef struct
+{
+  int8_t moveX; // -127..127
+  int8_t moveY;
+  uint8_t buttons; // ENV_FIRE
+  uint8_t reserved;
+} EnvAction;
+
+typedef struct
+{
+  uint8_t type; // EntityType
+  uint8_t pool; // EntityPool, 0xFF for the player
+  int16_t health;
+  float x, y; // screen pixels, centre
+  float vx, vy; // pixels per tick
+} EnvObject;
+
+typedef struct
+{
+  int32_t score;
+  uint8_t lives;
+  uint8_t weaponLevel;
+  uint16_t count; // objects filled in; the player is always first
+  uint32_t tick;  // into the current run
+  EnvObject objects[ENV_MAX_OBJECTS];
+} EnvObservation;
+
+typedef struct GameEnv GameEnv;
+
+// count games started from seed, seed + 1, ... NULL when out of memory.
+GameEnv *envCreate(int count, uint32_t seed);
+void envDestroy(GameEnv *env);
+int envCount(const GameEnv *env);
+
+// Restarts every game, again from seed, seed + 1, ...
+void envReset(GameEnv *env, uint32_t seed);
+
+// One tick of every game. actions, rewards (score gained) and dones hold
+// one entry per game; rewards and dones may be NULL. On the ESP32 the
+// batch is split across both cores.
+void envStep(GameEnv *env, const EnvAction *actions, float *rewards, uint8_t *dones);
+
+// One tick of games first .. first + n - 1 only, indexing the arrays the
+// same way as envStep. For trainers that run the batch on threads of
+// their own: disjoint ranges may be stepped at the same time.
+void envStepRange(GameEnv *env, int first, int n, const EnvAction *actions, float *rewards, uint8_t *dones);
+
+// Every game's entities, envCount() observations
+void envObserve(const GameEnv *env, EnvObservation *out);
+
+// Every game drawn as ENV_FRAME_WIDTH x ENV_FRAME_HEIGHT cells, envCount()
+// frames back to back. A cell holds 1 + the EntityType covering it, or 0.
+// Explosions and particles are left out.
+void envRender(const GameEnv *env, uint8_t *frames);
+
+#ifdef __cplusplus
+}
+#endif
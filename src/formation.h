@@ -0,0 +1,125 @@
+// ============================================================================
+// formation.h - Flight paths baked into arc-length tables
+// ============================================================================
+//
+// A path is a Catmull-Rom spline through a few control points. Evaluating
+// it per enemy per tick costs a cubic per axis, and equal steps in the
+// spline parameter are not equal distances, so ships would speed up and
+// slow down along it. PathTable walks the spline once and keeps
+// PATH_SAMPLES points spaced evenly by distance travelled. at(d) is then
+// one lookup and a lerp, and constant speed is just d += speed.
+//
+// A formation is one distance along a shared table. Each member samples
+// it a fixed lag behind the leader and adds its own screen offset, both
+// taken from a FormationShape.
+
+#pragma once
+
+#include <Arduino.h>
+
+#ifndef PATH_SAMPLES
+#define PATH_SAMPLES 64
+#endif
+
+#ifndef MAX_FORMATION_MEMBERS
+#define MAX_FORMATION_MEMBERS 10
+#endif
+
+struct PathPoint
+{
+  float x, y;
+};
+
+// Point on the Catmull-Rom spline through p[0..n-1] at t in 0..n-1. The
+// end points are repeated, so the curve starts and ends on them.
+static PathPoint catmullRom(const PathPoint *p, int n, float t)
+{
+  int i = constrain((int)t, 0, n - 2);
+  float u = t - i, u2 = u * u, u3 = u2 * u;
+  const PathPoint &p0 = p[max(i - 1, 0)];
+  const PathPoint &p1 = p[i];
+  const PathPoint &p2 = p[i + 1];
+  const PathPoint &p3 = p[min(i + 2, n - 1)];
+
+  float a = -0.5f * u3 + u2 - 0.5f * u;
+  float b = 1.5f * u3 - 2.5f * u2 + 1.0f;
+  float c = -1.5f * u3 + 2.0f * u2 + 0.5f * u;
+  float d = 0.5f * u3 - 0.5f * u2;
+  return {a * p0.x + b * p1.x + c * p2.x + d * p3.x,
+          a * p0.y + b * p1.y + c * p2.y + d * p3.y};
+}
+
+class PathTable
+{
+private:
+  PathPoint points[PATH_SAMPLES];
+  float invSpacing = 0;
+
+public:
+  float length = 0;
+
+  // Measures the spline in short chords, then places the samples an equal
+  // distance apart along them
+  void bake(const PathPoint *ctrl, int n)
+  {
+    const int CHORDS = 32; // per segment
+    int steps = (n - 1) * CHORDS;
+
+    length = 0;
+    PathPoint prev = ctrl[0];
+    for (int s = 1; s <= steps; s++)
+    {
+      PathPoint p = catmullRom(ctrl, n, (float)s / CHORDS);
+      length += hypotf(p.x - prev.x, p.y - prev.y);
+      prev = p;
+    }
+
+    float spacing = length / (PATH_SAMPLES - 1);
+    invSpacing = spacing > 0 ? 1.0f / spacing : 0;
+
+    points[0] = ctrl[0];
+    int k = 1;
+    float walked = 0;
+    prev = ctrl[0];
+    for (int s = 1; s <= steps && k < PATH_SAMPLES; s++)
+    {
+      PathPoint p = catmullRom(ctrl, n, (float)s / CHORDS);
+      float chord = hypotf(p.x - prev.x, p.y - prev.y);
+      while (k < PATH_SAMPLES && walked + chord >= k * spacing)
+      {
+        float f = chord > 0 ? (k * spacing - walked) / chord : 0;
+        points[k++] = {prev.x + (p.x - prev.x) * f, prev.y + (p.y - prev.y) * f};
+      }
+      walked += chord;
+      prev = p;
+    }
+    // Rounding can leave the last sample or two short of the end
+    while (k < PATH_SAMPLES)
+      points[k++] = ctrl[n - 1];
+  }
+
+  // Point d pixels along the path, held at either end outside 0..length
+  PathPoint at(float d) const
+  {
+    if (d <= 0)
+      return points[0];
+    float f = d * invSpacing;
+    int i = (int)f;
+    if (i >= PATH_SAMPLES - 1)
+      return points[PATH_SAMPLES - 1];
+    f -= i;
+    const PathPoint &a = points[i];
+    const PathPoint &b = points[i + 1];
+    return {a.x + (b.x - a.x) * f, a.y + (b.y - a.y) * f};
+  }
+};
+
+// Where each member flies relative to the leader: lag is how many pixels
+// behind it on the path, dx/dy a fixed offset on screen
+struct FormationShape
+{
+  uint8_t count;
+  int8_t dx[MAX_FORMATION_MEMBERS];
+  int8_t dy[MAX_FORMATION_MEMBERS];
+  uint8_t lag[MAX_FORMATION_MEMBERS];
+};
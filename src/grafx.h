@@ -1,3 +1,5 @@
+#pragma once
+
 #include <Arduino.h>
 
 // player_ship_map - 24x24 pixels, RGB565 format
@@ -183,3 +185,154 @@ const uint16_t powerup_weapon_map[] PROGMEM = {
 };
 // Total pixels: 256 (16x16)
 // Memory size: 512 bytes
+
+// explosion_map - 24x144 pixels, RGB565 format
+// Sprite sheet: 6 frames of 24x24, stacked top to bottom
+const uint16_t explosion_map[] PROGMEM = {
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xfde5, 0xff8f, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xfde5, 0xff8f, 0xff8f, 0xff8f, 0xfde5, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xfde5, 0xfde5, 0xfffc, 0xfffc, 0xff8f, 0xfde5, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xfde5, 0xfde5, 0xfde5, 0xff8f, 0xfffc, 0xff8f, 0xfde5, 0xfde5, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xfde5, 0xff8f, 0xff8f, 0xff8f, 0xfde5, 0xfde5, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xfde5, 0x0000, 0xfde5, 0xff8f, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xfde5, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xfde5, 0xf3c2, 0xfde5, 0xfde5, 0xfde5, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0xf3c2, 0xfde5, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xfde5, 0xfde5, 0xfde5, 0xff8f, 0xff8f, 0xfde5, 0xfde5, 0xfde5, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xf3c2, 0xfde5, 0xfde5, 0xfffc, 0xff8f, 0xff8f, 0xfde5, 0xf3c2, 0xfde5, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xfde5, 0xfde5, 0xff8f, 0xfffc, 0xfffc, 0xff8f, 0xfde5, 0xfde5, 0xfde5, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xfde5, 0xfde5, 0xff8f, 0xfde5, 0xff8f, 0xff8f, 0xfde5, 0xfde5, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xf3c2, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xfde5, 0xf3c2, 0xfde5, 0xfde5, 0xf3c2, 0x0000, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xf3c2, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0xb181, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0x0000, 0x0000, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xfde5, 0xf3c2, 0xf3c2, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xfde5, 0xfde5, 0xfde5, 0xf3c2, 0xf3c2, 0xf3c2, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0xf3c2, 0xf3c2, 0xf3c2, 0x0000, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0xf3c2, 0xf3c2, 0xfde5, 0xfde5, 0xff8f, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xf3c2, 0xfde5, 0xfde5, 0xfde5, 0xff8f, 0xff8f, 0xff8f, 0xfde5, 0xfde5, 0xf3c2, 0xf3c2, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xf3c2, 0xf3c2, 0xfde5, 0xff8f, 0xff8f, 0xff8f, 0xff8f, 0xfde5, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xf3c2, 0xf3c2, 0xfde5, 0xff8f, 0xfde5, 0xff8f, 0xfde5, 0xfde5, 0xf3c2, 0xf3c2, 0xf3c2, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0xf3c2, 0xf3c2, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0x0000, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xfde5, 0xf3c2, 0xf3c2, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0x0000, 0x0000, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0xb181, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0x0000, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0x0000, 0xb181, 0xb181, 0xb181, 0xb181, 0xb181, 0xb181, 0x0000, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0xb181, 0xf3c2, 0xb181, 0xf3c2, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0xb181, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0xf3c2, 0xb181, 0xf3c2, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0xf3c2, 0xf3c2, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0xb181, 0xb181, 0xb181, 0xf3c2, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0x0000, 0xfde5, 0xfde5, 0xfde5, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0xb181, 0xb181, 0xb181, 0xf3c2, 0xf3c2, 0xfde5, 0xfde5, 0x0000, 0x0000, 0xff8f, 0xfde5, 0xff8f, 0xfde5, 0xf3c2, 0xf3c2, 0xf3c2, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0xb181, 0xf3c2, 0xfde5, 0xfde5, 0x0000, 0x0000, 0x0000, 0x0000, 0xff8f, 0xfde5, 0xfde5, 0xfde5, 0xf3c2, 0xb181, 0xb181, 0xb181, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0xf3c2, 0xf3c2, 0xfde5, 0xfde5, 0xff8f, 0x0000, 0x0000, 0x0000, 0x0000, 0xfde5, 0xfde5, 0xfde5, 0xf3c2, 0xf3c2, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0xb181, 0xf3c2, 0xfde5, 0xfde5, 0xff8f, 0xff8f, 0x0000, 0x0000, 0xfde5, 0xff8f, 0xfde5, 0xfde5, 0xf3c2, 0xb181, 0xb181, 0xb181, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xfde5, 0xfde5, 0xfde5, 0xff8f, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0xf3c2, 0xb181, 0xb181, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xfde5, 0xfde5, 0xfde5, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0xb181, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xb181, 0xf3c2, 0xb181, 0xb181, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0xb181, 0xb181, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xb181, 0xf3c2, 0xb181, 0xb181, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0x0000, 0xb181, 0xb181, 0xb181, 0xb181, 0xb181, 0xb181, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x58a0, 0x58a0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x58a0, 0x58a0, 0x58a0, 0xb181, 0xb181, 0x58a0, 0x58a0, 0x58a0, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x58a0, 0xb181, 0x58a0, 0xb181, 0xb181, 0xb181, 0xb181, 0xb181, 0xb181, 0xb181, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x58a0, 0xb181, 0xb181, 0xb181, 0xb181, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0xb181, 0xb181, 0x58a0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x58a0, 0x58a0, 0xb181, 0xb181, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0xb181, 0x58a0, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xfde5, 0xfde5, 0xfde5, 0xfde5, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0xb181, 0x58a0, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0xb181, 0xb181, 0xb181, 0xb181, 0xf3c2, 0xfde5, 0xf3c2, 0xfde5, 0xfde5, 0x0000, 0x0000, 0xf3c2, 0xfde5, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0xb181, 0x58a0, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x58a0, 0xb181, 0xf3c2, 0xf3c2, 0xfde5, 0xfde5, 0x0000, 0x0000, 0x0000, 0x0000, 0xfde5, 0x0000, 0x0000, 0xf3c2, 0xf3c2, 0xb181, 0xf3c2, 0x58a0, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x58a0, 0xb181, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xfde5, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xfde5, 0xf3c2, 0xb181, 0xb181, 0x58a0, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x58a0, 0x58a0, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xfde5, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0x58a0, 0x0000, 0x0000,
+  0x0000, 0x58a0, 0x58a0, 0xb181, 0xf3c2, 0xf3c2, 0xfde5, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xfde5, 0xfde5, 0xf3c2, 0xf3c2, 0xb181, 0x58a0, 0x0000, 0x0000,
+  0x0000, 0x58a0, 0x0000, 0xb181, 0xf3c2, 0xf3c2, 0xfde5, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0xb181, 0xf3c2, 0xf3c2, 0xfde5, 0xfde5, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xfde5, 0xfde5, 0xf3c2, 0xb181, 0xb181, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0xb181, 0xf3c2, 0xf3c2, 0xfde5, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xfde5, 0xf3c2, 0xb181, 0xf3c2, 0xb181, 0xb181, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x58a0, 0x58a0, 0xb181, 0xf3c2, 0xf3c2, 0xfde5, 0xfde5, 0x0000, 0xfde5, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0xb181, 0xb181, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xfde5, 0x0000, 0xfde5, 0x0000, 0xfde5, 0xfde5, 0xf3c2, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x58a0, 0xb181, 0xf3c2, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xfde5, 0xf3c2, 0xfde5, 0xfde5, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0xb181, 0x58a0, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x58a0, 0xb181, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0xf3c2, 0xb181, 0xb181, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xb181, 0xb181, 0xb181, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0xb181, 0xb181, 0xb181, 0x58a0, 0x58a0, 0x58a0, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x58a0, 0x58a0, 0x58a0, 0xb181, 0xb181, 0xb181, 0xb181, 0xb181, 0xb181, 0xb181, 0xb181, 0x58a0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x58a0, 0x0000, 0xb181, 0x58a0, 0xb181, 0x58a0, 0x58a0, 0x58a0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x58a0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x58a0, 0x58a0, 0x0000, 0x58a0, 0x58a0, 0x0000, 0x58a0, 0x0000, 0x58a0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x58a0, 0x0000, 0x58a0, 0x58a0, 0x58a0, 0x58a0, 0x58a0, 0xb181, 0x58a0, 0x58a0, 0x58a0, 0x58a0, 0x58a0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x58a0, 0x0000, 0x58a0, 0x58a0, 0x58a0, 0xb181, 0xb181, 0xb181, 0xb181, 0xb181, 0xb181, 0xb181, 0x58a0, 0x58a0, 0x58a0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x58a0, 0x58a0, 0xb181, 0xb181, 0xb181, 0xb181, 0xb181, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0xb181, 0xb181, 0xb181, 0x58a0, 0x58a0, 0x58a0, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x58a0, 0x58a0, 0xb181, 0xb181, 0xb181, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xb181, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0x58a0, 0xb181, 0x58a0, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x58a0, 0x58a0, 0xb181, 0x58a0, 0xb181, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0x0000, 0x0000, 0xf3c2, 0x0000, 0xf3c2, 0xb181, 0xb181, 0xb181, 0x58a0, 0x58a0, 0x58a0, 0x0000, 0x0000,
+  0x0000, 0x58a0, 0x58a0, 0x58a0, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0xb181, 0x58a0, 0x0000, 0x0000,
+  0x58a0, 0x58a0, 0x58a0, 0xb181, 0xb181, 0xb181, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xb181, 0x58a0, 0x58a0, 0x0000,
+  0x58a0, 0x58a0, 0x58a0, 0xb181, 0xb181, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0x58a0, 0x0000,
+  0x58a0, 0x58a0, 0x58a0, 0xb181, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0x58a0, 0x58a0,
+  0x0000, 0x58a0, 0xb181, 0xb181, 0xf3c2, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0x58a0, 0x58a0,
+  0x58a0, 0x58a0, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0x58a0, 0x58a0,
+  0x58a0, 0x58a0, 0xb181, 0xf3c2, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xb181, 0xb181, 0x58a0, 0x58a0,
+  0x0000, 0xb181, 0x58a0, 0xb181, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xf3c2, 0xb181, 0x58a0, 0x58a0,
+  0x0000, 0xb181, 0xb181, 0xf3c2, 0xb181, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xb181, 0xb181, 0xb181, 0x58a0, 0x0000,
+  0x0000, 0x58a0, 0xb181, 0xb181, 0xf3c2, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0xf3c2, 0xf3c2, 0xb181, 0x58a0, 0x58a0, 0x0000,
+  0x58a0, 0x58a0, 0x58a0, 0xb181, 0xb181, 0xf3c2, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0x0000, 0xf3c2, 0xb181, 0xb181, 0x58a0, 0x58a0, 0x58a0,
+  0x0000, 0x0000, 0x58a0, 0xb181, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0x0000, 0xf3c2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xf3c2, 0x0000, 0xf3c2, 0xf3c2, 0xb181, 0x58a0, 0x58a0, 0x58a0, 0x0000,
+  0x0000, 0x0000, 0x58a0, 0x58a0, 0xb181, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0x0000, 0x0000, 0xf3c2, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0xb181, 0xb181, 0x58a0, 0x58a0, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x58a0, 0x58a0, 0x58a0, 0xb181, 0xb181, 0xb181, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0xb181, 0xb181, 0x58a0, 0x58a0, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x58a0, 0x58a0, 0xb181, 0x58a0, 0xb181, 0xb181, 0xb181, 0xb181, 0xf3c2, 0xf3c2, 0xb181, 0xb181, 0xb181, 0xb181, 0x58a0, 0x58a0, 0x58a0, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x58a0, 0x58a0, 0x58a0, 0xb181, 0xb181, 0xb181, 0xb181, 0xb181, 0xb181, 0x58a0, 0x58a0, 0x58a0, 0x58a0, 0x58a0, 0x58a0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x58a0, 0x0000, 0x58a0, 0x58a0, 0x58a0, 0x58a0, 0x58a0, 0x58a0, 0x58a0, 0x58a0, 0x58a0, 0x58a0, 0x58a0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x58a0, 0x58a0, 0x58a0, 0x58a0, 0x0000, 0x58a0, 0x58a0, 0x58a0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000
+};
+// Total pixels: 3456 (24x144)
+// Memory size: 6912 bytes
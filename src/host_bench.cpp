@@ -0,0 +1,555 @@
+// ============================================================================
+// host_bench.cpp - Microbenchmarks of the game's hot paths, on the host
+// ============================================================================
+//
+// Built only by the native_bench environment:
+//
+//   pio run -e native_bench && .pio/build/native_bench/program [options]
+//
+// or by hand with any C++11 compiler:
+//
+//   g++ -std=gnu++11 -O2 -DHOST_BENCH -Ibench/shim src/host_bench.cpp -o host_bench
+//
+// main.cpp is compiled into this file, with bench/shim standing in for the
+// Arduino core and LovyanGFX. The canvas is a real 16-bit buffer, so the
+// draw cases do the pixel work the device would - on a different CPU, so
+// compare runs with each other, never with device frame times.
+//
+// For each case and entity count, every pool is filled with that many
+// entities (or as many as it holds), spread over the screen with every
+// other player bullet on an enemy. The case is warmed up, then timed once
+// per repetition, each from a freshly built scene. Samples have the timer's
+// own cost taken off and are reported in ns: median, mean, min, p90 and
+// standard deviation.
+//
+// Options:
+//   --filter TEXT     only cases whose name contains TEXT
+//   --counts 0,10,50  entity counts to run each case at
+//   --reps N          timed repetitions (default 1000)
+//   --warmup N        untimed runs first (default 50)
+//   --csv FILE        save the results
+//   --compare FILE    show the median's change against a saved run
+//   --list            print the case names and stop
+//   --ovr FILE        time the update and render of a frame-overrun dump
+//                     (from tools/overrun_decode.py) instead of the cases
+//
+// ASSET_BUNDLE=<file> uses a built asset bundle instead of the built-in
+// sprites; STAGE_FILE=<file> streams a built stage, which drawStage needs.
+
+#ifdef HOST_BENCH
+
+#include "main.cpp"
+
+#define BENCH_SEED 0x5EED
+#define BENCH_REPS 1000
+#define BENCH_WARMUP 50
+#define BENCH_MAX_COUNTS 16
+#define BENCH_MAX_BASELINE 512
+
+static const int benchDefaultCounts[] = {0, 5, 10, 20, 50};
+
+// Keeps the results of the pure cases from being optimised away
+volatile float benchSink;
+
+static uint64_t benchNow()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// ---- Scene -----------------------------------------------------------------
+
+// Slot i of a pool, nullptr past its end
+static Entity *benchSlot(EntityPool p, int i)
+{
+  int size;
+  Entity *e = game.pool(p, size);
+  return i < size ? &e[i] : nullptr;
+}
+
+// A fresh run with n entities in every pool, classified for drawing
+static void benchScene(int n)
+{
+  game.startGame(BENCH_SEED);
+  // Brings the stage's first screen into the streamer's window, as the
+  // first frame's update would
+  if (background.active())
+    background.advance(game.stageY, SCROLL_SPEED);
+  for (int p = 0; p < POOL_COUNT; p++)
+  {
+    int size;
+    Entity *e = game.pool((EntityPool)p, size);
+    for (int i = 0; i < size; i++)
+      e[i].deactivate();
+  }
+
+  uint32_t rng = BENCH_SEED;
+  for (int i = 0; i < n; i++)
+  {
+    Entity *e;
+    Vec2 pos;
+    if ((e = benchSlot(POOL_ENEMIES, i)))
+    {
+      EntityType type = (EntityType)(ENEMY_BASIC + i % 3);
+      rng = mix32(rng);
+      pos = Vec2(20 + rng % (SCREEN_WIDTH - 40), 20 + (rng >> 16) % (SCREEN_HEIGHT / 2));
+      e->spawn(type, pos, Vec2(0, archetypes[type].speed));
+    }
+    if ((e = benchSlot(POOL_PLAYER_BULLETS, i)))
+    {
+      Entity *target = benchSlot(POOL_ENEMIES, i / 2);
+      rng = mix32(rng);
+      pos = i % 2 == 0 && target && target->active ? target->pos + Vec2(0, 4)
+                                                     : Vec2(rng % SCREEN_WIDTH, (rng >> 16) % SCREEN_HEIGHT);
+      e->spawn(BULLET_PLAYER, pos, Vec2(0, -archetypes[BULLET_PLAYER].speed));
+    }
+    if ((e = benchSlot(POOL_ENEMY_BULLETS, i)))
+    {
+      rng = mix32(rng);
+      pos = Vec2(rng % SCREEN_WIDTH, (rng >> 16) % SCREEN_HEIGHT);
+      e->spawn(BULLET_ENEMY, pos, Vec2(0, archetypes[BULLET_ENEMY].speed));
+    }
+    if ((e = benchSlot(POOL_POWERUPS, i)))
+    {
+      EntityType type = i % 2 ? POWERUP_HEALTH : POWERUP_WEAPON;
+      rng = mix32(rng);
+      pos = Vec2(rng % SCREEN_WIDTH, (rng >> 16) % SCREEN_HEIGHT);
+      e->spawn(type, pos, Vec2(0, archetypes[type].speed));
+    }
+    if ((e = benchSlot(POOL_EXPLOSIONS, i)))
+    {
+      rng = mix32(rng);
+      e->spawn(EXPLOSION, Vec2(rng % SCREEN_WIDTH, (rng >> 16) % SCREEN_HEIGHT), Vec2(0, 0));
+      e->play(CLIP_EXPLOSION);
+      e->animFrame = i % animClips[CLIP_EXPLOSION].frameCount;
+    }
+    if ((e = benchSlot(POOL_PARTICLES, i)))
+    {
+      float angle = (i % 8) / 8.0f * 2 * PI;
+      float v = archetypes[PARTICLE].speed;
+      rng = mix32(rng);
+      e->spawn(PARTICLE, Vec2(rng % SCREEN_WIDTH, (rng >> 16) % SCREEN_HEIGHT), Vec2(cosf(angle) * v, sinf(angle) * v));
+    }
+  }
+  game.classifyVisibility();
+}
+
+// ---- Cases -----------------------------------------------------------------
+
+static void benchGetRect()
+{
+  float sum = game.player.getRect().w;
+  for (int p = 0; p < POOL_COUNT; p++)
+  {
+    int size;
+    Entity *e = game.pool((EntityPool)p, size);
+    for (int i = 0; i < size; i++)
+      if (e[i].active)
+      {
+        Rect r = e[i].getRect();
+        sum += r.x + r.y + r.w + r.h;
+      }
+  }
+  benchSink = sum;
+}
+
+// The steering maths updateEnemies does, over every pooled entity
+static void benchVec2()
+{
+  float sum = 0;
+  for (int p = 0; p < POOL_COUNT; p++)
+  {
+    int size;
+    Entity *e = game.pool((EntityPool)p, size);
+    for (int i = 0; i < size; i++)
+      if (e[i].active)
+      {
+        Vec2 dir = (game.player.pos - e[i].pos).normalize();
+        Vec2 next = e[i].pos + e[i].vel + dir * 1.5f;
+        sum += next.length();
+      }
+  }
+  benchSink = sum;
+}
+
+// Entity count of the case being timed, for cases that scale with it
+// themselves
+static int benchCount;
+
+// The ring cases move n * 16 words through a 64-slot SpscRing on one
+// thread: the cost of the calls alone, without the cross-core traffic
+// (test/test_ring_stress runs the two sides on threads)
+static SpscRing<uint32_t, 64> benchRing;
+
+// One push or pop call per item, in turns of a full ring
+static void benchRingSingle()
+{
+  uint32_t out = 0;
+  for (int i = 0; i < benchCount * 16; i += 64)
+  {
+    int k = min(64, benchCount * 16 - i);
+    for (int j = 0; j < k; j++)
+      benchRing.push(i + j);
+    for (int j = 0; j < k; j++)
+      benchRing.pop(out);
+  }
+  benchSink = out;
+}
+
+// The same items 8 at a time through pushBatch() and popBatch()
+static void benchRingBatch()
+{
+  uint32_t items[8] = {};
+  for (int i = 0; i < benchCount * 16; i += 8)
+  {
+    benchRing.pushBatch(items, 8);
+    benchRing.popBatch(items, 8);
+  }
+  benchSink = items[0];
+}
+
+struct BenchCase
+{
+  const char *name;
+  void (*run)();
+  bool needsStage; // drawStage draws nothing without a streamed stage
+};
+
+static const BenchCase benchCases[] = {
+    {"updateEnemies", [] { game.updateEnemies(); }, false},
+    {"updateBullets", [] { game.updateBullets(); }, false},
+    {"updatePowerups", [] { game.updatePowerups(); }, false},
+    {"updateExplosions", [] { game.updateExplosions(); }, false},
+    {"updateParticles", [] { game.updateParticles(); }, false},
+    {"checkCollisions", [] { game.checkCollisions(); }, false},
+    {"classifyVisibility", [] { game.classifyVisibility(); }, false},
+    {"getRect", benchGetRect, false},
+    {"vec2", benchVec2, false},
+    {"ringSingle", benchRingSingle, false},
+    {"ringBatch", benchRingBatch, false},
+    {"drawBackground", [] { game.drawBackground(); }, false},
+    {"drawStage", [] { game.drawStage(); }, true},
+    {"drawParticles", [] { game.drawParticles(); }, false},
+    {"drawPowerups", [] { game.drawPowerups(); }, false},
+    {"drawBullets", [] { game.drawBullets(); }, false},
+    {"drawEnemies", [] { game.drawEnemies(); }, false},
+    {"drawPlayer", [] { game.drawPlayer(); }, false},
+    {"drawExplosions", [] { game.drawExplosions(); }, false},
+    {"drawHUD", [] { game.drawHUD(); }, false},
+    {"drawOverlay", [] { game.drawOverlay(); }, false},
+    {"drawUI", [] { input.drawUI(); }, false},
+    {"update", [] { game.update(); }, false},
+    {"render", [] { game.render(false); }, false},
+};
+
+#define BENCH_CASES (int)(sizeof(benchCases) / sizeof(benchCases[0]))
+
+// ---- Statistics ------------------------------------------------------------
+
+struct BenchStats
+{
+  float median, mean, min, p90, sd;
+};
+
+static int compareFloats(const void *a, const void *b)
+{
+  float x = *(const float *)a, y = *(const float *)b;
+  return x < y ? -1 : x > y;
+}
+
+// Sorts the samples
+static BenchStats summarise(float *samples, int n)
+{
+  qsort(samples, n, sizeof(float), compareFloats);
+  double sum = 0, squares = 0;
+  for (int i = 0; i < n; i++)
+    sum += samples[i];
+  double mean = sum / n;
+  for (int i = 0; i < n; i++)
+    squares += (samples[i] - mean) * (samples[i] - mean);
+  BenchStats s;
+  s.median = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+  s.mean = mean;
+  s.min = samples[0];
+  s.p90 = samples[(n - 1) * 90 / 100];
+  s.sd = n > 1 ? sqrt(squares / (n - 1)) : 0;
+  return s;
+}
+
+// Median cost of timing an empty call, taken off every sample
+static float timerOverhead(int reps)
+{
+  float *samples = (float *)malloc(reps * sizeof(float));
+  void (*volatile nothing)() = [] {};
+  for (int r = 0; r < reps; r++)
+  {
+    uint64_t t0 = benchNow();
+    nothing();
+    samples[r] = benchNow() - t0;
+  }
+  float overhead = summarise(samples, reps).median;
+  free(samples);
+  return overhead;
+}
+
+// ---- Baseline --------------------------------------------------------------
+
+struct BenchBaseline
+{
+  char name[32];
+  int n;
+  float median;
+};
+
+static BenchBaseline baseline[BENCH_MAX_BASELINE];
+static int baselineCount = 0;
+
+static bool loadBaseline(const char *path)
+{
+  FILE *f = fopen(path, "r");
+  if (!f)
+    return false;
+  char line[160];
+  while (fgets(line, sizeof(line), f) && baselineCount < BENCH_MAX_BASELINE)
+  {
+    BenchBaseline &b = baseline[baselineCount];
+    if (sscanf(line, "%31[^,],%d,%f", b.name, &b.n, &b.median) == 3)
+      baselineCount++;
+  }
+  fclose(f);
+  return true;
+}
+
+static const BenchBaseline *findBaseline(const char *name, int n)
+{
+  for (int i = 0; i < baselineCount; i++)
+    if (baseline[i].n == n && strcmp(baseline[i].name, name) == 0)
+      return &baseline[i];
+  return nullptr;
+}
+
+// ---- Overrun replay --------------------------------------------------------
+
+static OverrunDump benchDump;
+
+// Reads a raw dump as tools/overrun_decode.py writes it; the entity list
+// may stop after the last live entity
+static bool loadDump(const char *path)
+{
+  FILE *f = fopen(path, "rb");
+  if (!f)
+    return false;
+  memset(&benchDump, 0, sizeof(benchDump));
+  size_t n = fread(&benchDump, 1, sizeof(benchDump), f);
+  fclose(f);
+  size_t head = offsetof(OverrunDump, game) + offsetof(GameSnapshot, entities);
+  return n >= head && benchDump.magic == OverrunDump::MAGIC && benchDump.game.count <= MAX_POOLED_ENTITIES &&
+         n >= head + benchDump.game.count * sizeof(PackedEntity);
+}
+
+// Puts the game back where it was before the slow frame, with that
+// frame's input waiting
+static void benchDumpFrame()
+{
+  game.restore(benchDump.game);
+  InputSystem::InputSample s = {Vec2(benchDump.moveX / 127.0f, benchDump.moveY / 127.0f), benchDump.fire != 0,
+                                benchDump.touching != 0};
+  input.inject(s);
+  input.consume();
+}
+
+static void benchDumpUpdate() { game.update(); }
+static void benchDumpRender() { game.render(false); }
+
+// Times the dumped frame's update and render, each from a fresh restore
+static void runDump(float *samples, int reps, int warmup, float overhead, FILE *csv)
+{
+  printf("HOSTBENCH frame %u took %u us of %u on the device:", benchDump.frame, benchDump.frameUs,
+         benchDump.budgetUs);
+  for (int s = 0; s < SPAN_COUNT; s++)
+    printf(" %s %u", FrameProfiler::spanName((ProfileSpan)s), benchDump.spanUs[s]);
+  printf("\n");
+  printf("%-20s %4s %10s %10s %10s %10s %10s\n", "case", "n", "median", "mean", "min", "p90", "sd");
+
+  static const BenchCase parts[] = {{"ovrUpdate", benchDumpUpdate, false}, {"ovrRender", benchDumpRender, false}};
+  for (const BenchCase &part : parts)
+  {
+    for (int r = -warmup; r < reps; r++)
+    {
+      benchDumpFrame();
+      // render draws what update left, so it is timed after an untimed one
+      if (part.run == benchDumpRender)
+        game.update();
+      uint64_t t0 = benchNow();
+      part.run();
+      float ns = benchNow() - t0 - overhead;
+      if (r >= 0)
+        samples[r] = ns > 0 ? ns : 0;
+    }
+    BenchStats s = summarise(samples, reps);
+    printf("%-20s %4u %10.1f %10.1f %10.1f %10.1f %10.1f\n", part.name, benchDump.game.count, s.median, s.mean,
+           s.min, s.p90, s.sd);
+    if (csv)
+      fprintf(csv, "%s,%u,%.1f,%.1f,%.1f,%.1f,%.1f\n", part.name, benchDump.game.count, s.median, s.mean, s.min,
+              s.p90, s.sd);
+  }
+}
+
+// ---- Runner ----------------------------------------------------------------
+
+static int parseCounts(const char *list, int *counts)
+{
+  int n = 0;
+  while (*list && n < BENCH_MAX_COUNTS)
+  {
+    char *end;
+    long v = strtol(list, &end, 10);
+    if (end == list || v < 0)
+      return 0;
+    counts[n++] = v;
+    list = *end == ',' ? end + 1 : end;
+  }
+  return n;
+}
+
+static int usage()
+{
+  printf("usage: host_bench [--filter TEXT] [--counts 0,10,50] [--reps N] [--warmup N] [--csv FILE] "
+         "[--compare FILE] [--list] [--ovr FILE]\n");
+  return 2;
+}
+
+int main(int argc, char **argv)
+{
+  const char *filter = nullptr, *csvPath = nullptr, *comparePath = nullptr, *ovrPath = nullptr;
+  int counts[BENCH_MAX_COUNTS];
+  int countCount = sizeof(benchDefaultCounts) / sizeof(benchDefaultCounts[0]);
+  memcpy(counts, benchDefaultCounts, sizeof(benchDefaultCounts));
+  int reps = BENCH_REPS, warmup = BENCH_WARMUP;
+
+  for (int i = 1; i < argc; i++)
+  {
+    const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (strcmp(argv[i], "--list") == 0)
+    {
+      for (int c = 0; c < BENCH_CASES; c++)
+        printf("%s\n", benchCases[c].name);
+      return 0;
+    }
+    if (!value)
+      return usage();
+    if (strcmp(argv[i], "--filter") == 0)
+      filter = value;
+    else if (strcmp(argv[i], "--counts") == 0)
+      countCount = parseCounts(value, counts);
+    else if (strcmp(argv[i], "--reps") == 0)
+      reps = atoi(value);
+    else if (strcmp(argv[i], "--warmup") == 0)
+      warmup = atoi(value);
+    else if (strcmp(argv[i], "--csv") == 0)
+      csvPath = value;
+    else if (strcmp(argv[i], "--compare") == 0)
+      comparePath = value;
+    else if (strcmp(argv[i], "--ovr") == 0)
+      ovrPath = value;
+    else
+      return usage();
+    i++;
+  }
+  if (!countCount || reps <= 0 || warmup < 0)
+    return usage();
+  if (comparePath && !loadBaseline(comparePath))
+  {
+    printf("cannot read %s\n", comparePath);
+    return 1;
+  }
+  if (ovrPath && !loadDump(ovrPath))
+  {
+    printf("%s is not an overrun dump\n", ovrPath);
+    return 1;
+  }
+
+  setup();
+  deferred.finish();
+  const char *stagePath = getenv("STAGE_FILE");
+  FileStageSource stageFile(stagePath ? stagePath : "");
+  if (stagePath && !background.begin(&stageFile, SCREEN_WIDTH, SCREEN_HEIGHT))
+    printf("cannot stream %s\n", stagePath);
+
+  FILE *csv = csvPath ? fopen(csvPath, "w") : nullptr;
+  if (csvPath && !csv)
+  {
+    printf("cannot write %s\n", csvPath);
+    return 1;
+  }
+  if (csv)
+    fprintf(csv, "case,n,median_ns,mean_ns,min_ns,p90_ns,sd_ns\n");
+
+  float overhead = timerOverhead(reps * 10);
+  printf("\nHOSTBENCH %d reps after %d warm-up, timer overhead %.0f ns taken off\n", reps, warmup, overhead);
+  printf("HOSTBENCH pools hold enemies %d, player bullets %d, enemy bullets %d, powerups %d, explosions %d, "
+         "particles %d\n",
+         MAX_ENEMIES, MAX_PLAYER_BULLETS, MAX_ENEMY_BULLETS, MAX_POWERUPS, MAX_EXPLOSIONS, MAX_PARTICLES);
+  if (ovrPath)
+  {
+    float *samples = (float *)malloc(reps * sizeof(float));
+    runDump(samples, reps, warmup, overhead, csv);
+    free(samples);
+    if (csv)
+      fclose(csv);
+    printf("HOSTBENCH times in ns per call\n");
+    return 0;
+  }
+  printf("%-20s %4s %10s %10s %10s %10s %10s%s\n", "case", "n", "median", "mean", "min", "p90", "sd",
+         baselineCount ? "   vs base" : "");
+
+  float *samples = (float *)malloc(reps * sizeof(float));
+  for (int c = 0; c < BENCH_CASES; c++)
+  {
+    const BenchCase &bc = benchCases[c];
+    if (filter && !strstr(bc.name, filter))
+      continue;
+    if (bc.needsStage && !background.active())
+    {
+      printf("%-20s skipped, set STAGE_FILE to a built stage\n", bc.name);
+      continue;
+    }
+
+    for (int k = 0; k < countCount; k++)
+    {
+      int n = counts[k];
+      benchCount = n;
+      for (int w = 0; w < warmup; w++)
+      {
+        benchScene(n);
+        bc.run();
+      }
+      for (int r = 0; r < reps; r++)
+      {
+        benchScene(n);
+        uint64_t t0 = benchNow();
+        bc.run();
+        float ns = benchNow() - t0 - overhead;
+        samples[r] = ns > 0 ? ns : 0;
+      }
+      BenchStats s = summarise(samples, reps);
+
+      printf("%-20s %4d %10.1f %10.1f %10.1f %10.1f %10.1f", bc.name, n, s.median, s.mean, s.min, s.p90, s.sd);
+      const BenchBaseline *b = baselineCount ? findBaseline(bc.name, n) : nullptr;
+      if (b && b->median > 0)
+        printf("   %+6.1f%%", (s.median - b->median) * 100 / b->median);
+      else if (baselineCount)
+        printf("        new");
+      printf("\n");
+      if (csv)
+        fprintf(csv, "%s,%d,%.1f,%.1f,%.1f,%.1f,%.1f\n", bc.name, n, s.median, s.mean, s.min, s.p90, s.sd);
+    }
+  }
+  free(samples);
+  if (csv)
+    fclose(csv);
+  printf("HOSTBENCH times in ns per call\n");
+  return 0;
+}
+
+#endif
@@ -5,6 +5,32 @@
 #include <Arduino.h>
 #include <LovyanGFX.hpp>
 #include "grafx.h"
+#include "assets.h"
+#include "asset_cache.h"
+#include "ring_buffer.h"
+#include "profiler.h"
+#include "telemetry.h"
+#include "replays.h"
+#include "pool_capacity.h"
+#include "pool_stats.h"
+#include "bg_stream.h"
+#include "rotation_cache.h"
+#include "blit.h"
+#include "bullet_batch.h"
+#include "aabb_kernel.h"
+#include "script.h"
+#include "formation.h"
+#include "stage_gen.h"
+#include "world.h"
+#include "rewind.h"
+#include "env_api.h"
+#include "console.h"
+#include "overdraw.h"
+#include "boot.h"
+
+#ifdef ARDUINO
+#include <esp_heap_caps.h>
+#endif
 
 // ============================================================================
 // CONFIGURATION
@@ -15,16 +41,61 @@
 #define GAME_FPS 30
 #define FRAME_TIME (1000 / GAME_FPS)
 
+// Pixels the stage scrolls per frame
+#define SCROLL_SPEED 1.0f
+
 // Touch calibration - adjust these for your screen
 #define TOUCH_THRESHOLD 10
 
-// Game constants
-#define MAX_ENEMIES 20
-#define MAX_PLAYER_BULLETS 30
-#define MAX_ENEMY_BULLETS 40
-#define MAX_POWERUPS 5
-#define MAX_EXPLOSIONS 10
-#define MAX_PARTICLES 50
+// Game constants - pool sizes (MAX_ENEMIES etc.) live in pool_capacity.h
+
+// Frames an enemy flashes white after taking a hit that did not kill it
+#define HIT_FLASH_TICKS 3
+
+// Stage and wave scripts alive at once, and the bytes each one may use
+#define MAX_SCRIPTS 8
+#define SCRIPT_FRAME_BYTES 48
+
+// Formations in flight at once
+#define MAX_FORMATIONS 4
+
+// Time the stage generator may spend per tick building segments ahead
+#define GEN_SLICE_US 100
+
+// Placed world: its height in pixels, how many things are placed in it
+// per run, and how far above the screen they wake up
+#define WORLD_HEIGHT (64 * SECTOR_SIZE)
+#define WORLD_PLACEMENTS 120
+#define WAKE_MARGIN 64
+
+// Stream a map generated from the run seed instead of the one in flash
+// (the stage partition still supplies the tileset)
+#define PROCEDURAL_MAP 1
+
+// Frame overrun watchdog - dump state when a frame takes this many budgets
+#define OVERRUN_FACTOR 3
+
+// Frames between binary telemetry records, 0 = plain text FPS only.
+// Binary and text output share the Serial port, so enable one at a time.
+#define TELEMETRY_INTERVAL 0
+
+// Print every finished run over Serial as a replay for replays.h
+#define RECORD_REPLAYS 0
+
+// Rewind history: a snapshot every REWIND_INTERVAL ticks as deltas in
+// REWIND_BYTES (PSRAM when fitted), and REWIND_TICKS of inputs to
+// re-simulate from them. 0 disables it.
+#define REWIND_ENABLED 1
+#define REWIND_INTERVAL 15
+#define REWIND_TICKS (30 * GAME_FPS)
+#define REWIND_BYTES (128 * 1024)
+
+// Deferred setup steps may take this long between title screen frames
+#define BOOT_DEFER_BUDGET_US 8000
+
+// Time the Serial command console may take per frame, 0 = no console.
+// Like telemetry it shares the port, so leave it off while streaming.
+#define CONSOLE_BUDGET_US 200
 
 // ============================================================================
 // LOVYANGFX SETUP - Configure for your ILI9488
@@ -162,6 +233,11 @@ public:
     ENEMY_SHOOT
   };
 
+private:
+  // Game code only queues effects; update() (or a future mixer task) plays them
+  SpscRing<uint8_t, 16> events;
+
+public:
   void init()
   {
     ledcSetup(0, 2000, 8);
@@ -170,6 +246,27 @@ public:
   }
 
   void play(SoundEffect effect)
+  {
+    events.push((uint8_t)effect);
+  }
+
+  void update()
+  {
+    // Only one tone at a time, so the most recent effect of the frame wins
+    uint8_t pending[16];
+    size_t count = events.popBatch(pending, 16);
+    if (count > 0)
+      start((SoundEffect)pending[count - 1]);
+
+    if (isPlaying && millis() - soundStartTime > currentSound.duration)
+    {
+      ledcWriteTone(0, 0);
+      isPlaying = false;
+    }
+  }
+
+private:
+  void start(SoundEffect effect)
   {
     // // SFW ;-)
     // return;
@@ -194,16 +291,6 @@ public:
     }
   }
 
-  void update()
-  {
-    if (isPlaying && millis() - soundStartTime > currentSound.duration)
-    {
-      ledcWriteTone(0, 0);
-      isPlaying = false;
-    }
-  }
-
-private:
   void playTone(int freq, int duration)
   {
     currentSound = {freq, duration};
@@ -214,6 +301,66 @@ private:
 };
 
 SoundSystem sound;
+AssetStore assets;
+AssetCache spriteCache;
+
+// Drawn every frame, keep them out of LRU eviction
+void pinHotSprites()
+{
+  spriteCache.pin(SPRITE_PLAYER);
+  spriteCache.pin(SPRITE_BULLET_PLAYER);
+  spriteCache.pin(SPRITE_BULLET_ENEMY);
+}
+
+RotationCache rotations;
+ColorLut hitFlash;
+BulletBatch<MAX_PLAYER_BULLETS> playerBulletBatch;
+BulletBatch<MAX_ENEMY_BULLETS> enemyBulletBatch;
+
+// Ships that turn get pre-rotated headings; prints what each one costs
+void buildRotations()
+{
+  static const SpriteId turning[] = {SPRITE_PLAYER, SPRITE_ENEMY_BASIC, SPRITE_ENEMY_FAST, SPRITE_ENEMY_TANK};
+  uint32_t total = 0;
+  for (SpriteId id : turning)
+  {
+    if (!rotations.build(id, spriteCache.get(id)))
+    {
+      Serial.printf("ROT sprite=%d failed, drawn upright\n", id);
+      continue;
+    }
+    Serial.printf("ROT sprite=%d %d headings, %u bytes\n", id, ROTATION_STEPS, rotations.bytes(id));
+    total += rotations.bytes(id);
+  }
+  Serial.printf("ROT total %u bytes\n", total);
+}
+PoolStatsStore poolStore;
+FrameProfiler profiler;
+
+// Drawing knobs the console (CONSOLE) turns while the game runs. None of
+// them change the simulation.
+struct RenderSettings
+{
+  bool fastBlits = true; // unclipped blits for sprites fully on screen
+  bool overlay = false;  // frame timings over the game
+  uint8_t quality = 2;   // 2 full, 1 star field for the stage, 0 no background or particles
+};
+RenderSettings settings;
+
+// Pixel writes per block, counted only while active (console: overdraw)
+OverdrawMap overdraw;
+
+// Boot phases, and the setup left for loop() to finish (see setup())
+BootTrace boot;
+DeferredInit deferred;
+
+BackgroundStreamer background;
+#ifdef ARDUINO
+PartitionStageSource stageSource;
+#if PROCEDURAL_MAP
+ProceduralStageSource proceduralMap(stageSource, 1);
+#endif
+#endif
 
 // ============================================================================
 // INPUT SYSTEM WITH MULTITOUCH SUPPORT
@@ -244,12 +391,55 @@ private:
   const int FIRE_BUTTON_Y = SCREEN_HEIGHT - 60;
   const int FIRE_BUTTON_RADIUS = 40;
 
+public:
+  // One processed touch reading, handed from the sampler to the game loop
+  struct InputSample
+  {
+    Vec2 movement;
+    bool fire;
+    bool touching;
+  };
+
+private:
+  SpscRing<InputSample, 8> samples;
+
 public:
   void update()
   {
-    isTouching = false;
-    joystickPos = Vec2(0, 0);
+    sample();
+    consume();
+  }
+
+  // Feeds a recorded sample instead of reading the touch controller
+  void inject(const InputSample &s)
+  {
+    samples.push(s);
+  }
+
+  void consume()
+  {
+    // Fold everything sampled since the last frame: latest stick position,
+    // but a fire or touch seen in any sample still counts
+    InputSample pending[8];
+    size_t count = samples.popBatch(pending, 8);
+    if (count == 0)
+      return;
+    joystickPos = pending[count - 1].movement;
     firePressed = false;
+    isTouching = false;
+    for (size_t i = 0; i < count; i++)
+    {
+      firePressed |= pending[i].fire;
+      isTouching |= pending[i].touching;
+    }
+  }
+
+  // Producer side: reads the touch controller and publishes one sample.
+  // It also rewrites touchPoints[], which drawUI() reads on the loop task,
+  // so moving it into its own task needs those handed over as well.
+  void sample()
+  {
+    InputSample s = {Vec2(0, 0), false, false};
     
     // Clear old touch points
     for (int i = 0; i < MAX_TOUCH_POINTS; i++) {
@@ -265,7 +455,7 @@ public:
       touchPoints[0].active = true;
       touchPoints[0].pos = Vec2(tx, ty);
       touchPoints[0].id = 0;
-      isTouching = true;
+      s.touching = true;
       touchCount++;
     }
     
@@ -278,7 +468,7 @@ public:
           touchPoints[touchCount].pos = Vec2(tp.x, tp.y);
           touchPoints[touchCount].id = i;
           touchCount++;
-          isTouching = true;
+          s.touching = true;
         }
       }
     }
@@ -302,7 +492,10 @@ public:
             dx = (dx / dist) * maxDist;
             dy = (dy / dist) * maxDist;
           }
-          joystickPos = Vec2(dx / maxDist, dy / maxDist);
+          // Quantised to the 1/127 steps replays store, so recorded
+          // runs play back exactly
+          s.movement = Vec2(round(dx / maxDist * 127) / 127.0f,
+                            round(dy / maxDist * 127) / 127.0f);
         }
       }
       
@@ -314,10 +507,12 @@ public:
         
         // If touch is within fire button radius OR anywhere on right side
         if (dist < FIRE_BUTTON_RADIUS + 20 || true) {  // Always fire when touching right side
-          firePressed = true;
+          s.fire = true;
         }
       }
     }
+
+    samples.push(s);
   }
 
   Vec2 getMovement() const { return joystickPos; }
@@ -337,11 +532,15 @@ public:
     canvas.drawCircle(JOYSTICK_CENTER_X, JOYSTICK_CENTER_Y, JOYSTICK_RADIUS, TFT_DARKGREY);
     canvas.fillCircle(JOYSTICK_CENTER_X, JOYSTICK_CENTER_Y, JOYSTICK_RADIUS - 2,
                       canvas.color565(40, 40, 40));
+    overdraw.add(OD_CONTROLS, JOYSTICK_CENTER_X - JOYSTICK_RADIUS, JOYSTICK_CENTER_Y - JOYSTICK_RADIUS,
+                 2 * JOYSTICK_RADIUS + 1, 2 * JOYSTICK_RADIUS + 1, (int32_t)(2 * PI * JOYSTICK_RADIUS));
+    overdraw.addCircle(OD_CONTROLS, JOYSTICK_CENTER_X, JOYSTICK_CENTER_Y, JOYSTICK_RADIUS - 2);
     
     // Draw joystick stick
     int stickX = JOYSTICK_CENTER_X + joystickPos.x * (JOYSTICK_RADIUS - 20);
     int stickY = JOYSTICK_CENTER_Y + joystickPos.y * (JOYSTICK_RADIUS - 20);
     canvas.fillCircle(stickX, stickY, 20, TFT_WHITE);
+    overdraw.addCircle(OD_CONTROLS, stickX, stickY, 20);
     
     // Draw fire button
     canvas.fillCircle(FIRE_BUTTON_X, FIRE_BUTTON_Y, FIRE_BUTTON_RADIUS,
@@ -350,6 +549,9 @@ public:
     canvas.setTextDatum(MC_DATUM);
     canvas.setTextSize(1);
     canvas.drawString("FIRE", FIRE_BUTTON_X, FIRE_BUTTON_Y);
+    overdraw.addCircle(OD_CONTROLS, FIRE_BUTTON_X, FIRE_BUTTON_Y, FIRE_BUTTON_RADIUS);
+    overdraw.add(OD_CONTROLS, FIRE_BUTTON_X - canvas.textWidth("FIRE") / 2, FIRE_BUTTON_Y - canvas.fontHeight() / 2,
+                 canvas.textWidth("FIRE"), canvas.fontHeight());
     
     // Debug: Draw touch points (optional - comment out in production)
     for (int i = 0; i < MAX_TOUCH_POINTS; i++) {
@@ -367,6 +569,11 @@ InputSystem input;
 // ENTITY SYSTEM
 // ============================================================================
 
+// Simulation clock in ms. Advances exactly FRAME_TIME per Game::update() so
+// the simulation depends only on its inputs and the random seed, not on
+// how long frames took to render.
+unsigned long gameTime = 0;
+
 enum EntityType
 {
   PLAYER,
@@ -381,6 +588,65 @@ enum EntityType
   PARTICLE
 };
 
+// ============================================================================
+// ENTITY ARCHETYPES
+// ============================================================================
+
+// Loot rolled when an entity is destroyed: chance in percent, then one of
+// the items picked with equal odds
+struct DropTable
+{
+  uint8_t chance;
+  uint8_t count;
+  EntityType items[2];
+};
+
+// Everything fixed per EntityType. Spawn, update, collision and draw code
+// read this row instead of switching on the type, so a new kind of entity
+// is one more row here.
+struct Archetype
+{
+  int16_t hp;
+  uint8_t width, height; // draw size
+  float hitW, hitH;      // collision box, centred on pos
+  SpriteId sprite;       // SPRITE_COUNT when drawn without one
+  float speed;           // px per frame
+  uint16_t score;
+  uint16_t color;
+  DropTable drops;
+};
+
+#define NO_DROPS {0, 0, {PLAYER, PLAYER}}
+#define ENEMY_DROPS {20, 2, {POWERUP_WEAPON, POWERUP_HEALTH}}
+
+constexpr Archetype archetypes[] = {
+    // hp  w   h   hitW hitH sprite                 speed  score color        drops
+    {100, 24, 24, 24, 24, SPRITE_PLAYER,         10.0f, 0,   TFT_CYAN,    NO_DROPS},    // PLAYER
+    {10,  20, 20, 20, 20, SPRITE_ENEMY_BASIC,    1.5f,  100, TFT_RED,     ENEMY_DROPS}, // ENEMY_BASIC
+    {5,   16, 16, 16, 16, SPRITE_ENEMY_FAST,     3.0f,  100, TFT_YELLOW,  ENEMY_DROPS}, // ENEMY_FAST
+    {30,  28, 28, 28, 28, SPRITE_ENEMY_TANK,     0.8f,  100, TFT_PURPLE,  ENEMY_DROPS}, // ENEMY_TANK
+    {1,   4,  8,  4,  8,  SPRITE_BULLET_PLAYER,  8.0f,  0,   TFT_WHITE,   NO_DROPS},    // BULLET_PLAYER
+    {1,   4,  8,  4,  8,  SPRITE_BULLET_ENEMY,   3.0f,  0,   TFT_ORANGE,  NO_DROPS},    // BULLET_ENEMY
+    {1,   16, 16, 16, 16, SPRITE_POWERUP_WEAPON, 1.0f,  0,   TFT_GREEN,   NO_DROPS},    // POWERUP_WEAPON
+    {1,   16, 16, 16, 16, SPRITE_POWERUP_HEALTH, 1.0f,  0,   TFT_MAGENTA, NO_DROPS},    // POWERUP_HEALTH
+    {1,   24, 24, 0,  0,  SPRITE_EXPLOSION,      0.0f,  0,   TFT_ORANGE,  NO_DROPS},    // EXPLOSION
+    {10,  5,  5,  0,  0,  SPRITE_COUNT,          2.0f,  0,   TFT_YELLOW,  NO_DROPS},    // PARTICLE
+};
+static_assert(sizeof(archetypes) / sizeof(Archetype) == PARTICLE + 1, "one archetype per EntityType");
+
+#undef NO_DROPS
+#undef ENEMY_DROPS
+
+#define NO_FORMATION 0xFF
+
+// Where an entity's draw box falls against the screen, set once per frame
+enum Visibility : uint8_t
+{
+  VIS_CULLED,  // entirely off screen, not drawn
+  VIS_PARTIAL, // straddles an edge, drawn with clipping
+  VIS_VISIBLE  // entirely on screen
+};
+
 struct Entity
 {
   bool active;
@@ -391,7 +657,13 @@ struct Entity
   int health;
   uint32_t color;
   int animFrame;
-  unsigned long lastAnimTime;
+  uint8_t animClip;  // AnimClipId, CLIP_NONE when still
+  uint8_t animTicks; // ticks left on the current frame
+  int8_t animDir;
+  uint8_t flashTicks; // hit flash frames left
+  uint8_t visibility; // Visibility, valid during rendering
+  uint8_t formation;  // Game::formations index, NO_FORMATION when flying free
+  uint8_t member;     // place in the formation's shape
 
   void init(EntityType t, Vec2 p, Vec2 v, float w, float h, int hp, uint32_t col)
   {
@@ -404,7 +676,26 @@ struct Entity
     health = hp;
     color = col;
     animFrame = 0;
-    lastAnimTime = millis();
+    animClip = CLIP_NONE;
+    flashTicks = 0;
+    formation = NO_FORMATION;
+  }
+
+  void play(AnimClipId clip)
+  {
+    animClip = clip;
+    animFrame = 0;
+    animDir = 1;
+    animTicks = animClips[clip].frames[0].ticks;
+  }
+
+  bool animating() const { return animClip != CLIP_NONE; }
+
+  // Fresh entity with the stock properties of its archetype
+  void spawn(EntityType t, Vec2 p, Vec2 v)
+  {
+    const Archetype &a = archetypes[t];
+    init(t, p, v, a.width, a.height, a.hp, a.color);
   }
 
   Rect getRect() const
@@ -412,16 +703,226 @@ struct Entity
     return Rect(pos.x - width / 2, pos.y - height / 2, width, height);
   }
 
+  Rect hitbox() const
+  {
+    const Archetype &a = archetypes[type];
+    return Rect(pos.x - a.hitW / 2, pos.y - a.hitH / 2, a.hitW, a.hitH);
+  }
+
   void deactivate()
   {
     active = false;
   }
 };
 
+// ============================================================================
+// ANIMATION
+// ============================================================================
+
+// Steps every animated entity in a pool by one tick. Run once per update
+// over each pool instead of checking timers entity by entity.
+void animateEntities(Entity *e, int n)
+{
+  for (int i = 0; i < n; i++)
+  {
+    Entity &a = e[i];
+    if (!a.active || a.animClip == CLIP_NONE || --a.animTicks)
+      continue;
+
+    const AnimClip &clip = animClips[a.animClip];
+    int next = a.animFrame + a.animDir;
+    if (next < 0 || next >= clip.frameCount)
+    {
+      if (clip.loop == ANIM_ONCE)
+      {
+        a.animClip = CLIP_NONE;
+        continue;
+      }
+      if (clip.loop == ANIM_LOOP)
+        next = 0;
+      else
+      {
+        a.animDir = -a.animDir;
+        next = clip.frameCount > 1 ? a.animFrame + a.animDir : 0;
+      }
+    }
+    a.animFrame = next;
+    a.animTicks = clip.frames[next].ticks;
+  }
+}
+
+// ============================================================================
+// FLIGHT PATHS & FORMATIONS
+// ============================================================================
+
+enum PathId
+{
+  PATH_SWOOP_LEFT,
+  PATH_SWOOP_RIGHT,
+  PATH_WEAVE,
+  PATH_COUNT
+};
+
+// Control points in screen pixels. Every path starts above the screen and
+// ends far enough below it for updateEnemies() to retire the ship.
+const PathPoint swoopLeftPath[] = {{50, -40}, {50, 120}, {160, 240}, {270, 300}, {270, 540}};
+const PathPoint swoopRightPath[] = {{270, -40}, {270, 120}, {160, 240}, {50, 300}, {50, 540}};
+const PathPoint weavePath[] = {{160, -40}, {60, 80}, {260, 180}, {60, 280}, {260, 380}, {160, 540}};
+
+struct PathDef
+{
+  const PathPoint *points;
+  uint8_t count;
+};
+
+const PathDef pathDefs[] = {
+    {swoopLeftPath, sizeof(swoopLeftPath) / sizeof(PathPoint)},
+    {swoopRightPath, sizeof(swoopRightPath) / sizeof(PathPoint)},
+    {weavePath, sizeof(weavePath) / sizeof(PathPoint)},
+};
+static_assert(sizeof(pathDefs) / sizeof(PathDef) == PATH_COUNT, "one PathDef per PathId");
+
+PathTable paths[PATH_COUNT];
+
+void bakePaths()
+{
+  for (int i = 0; i < PATH_COUNT; i++)
+  {
+    paths[i].bake(pathDefs[i].points, pathDefs[i].count);
+    Serial.printf("PATH %d length=%.0fpx\n", i, paths[i].length);
+  }
+}
+
+enum ShapeId
+{
+  SHAPE_LINE,
+  SHAPE_VEE,
+  SHAPE_COUNT
+};
+
+const FormationShape formationShapes[] = {
+    // count dx                  dy         lag
+    {5, {0, 0, 0, 0, 0},       {0},       {0, 28, 56, 84, 112}}, // SHAPE_LINE
+    {5, {0, -18, 18, -36, 36}, {0},       {0, 22, 22, 44, 44}},  // SHAPE_VEE
+};
+static_assert(sizeof(formationShapes) / sizeof(FormationShape) == SHAPE_COUNT, "one shape per ShapeId");
+
+// One formation in flight: members are the enemies whose formation field
+// points here
+struct Formation
+{
+  bool active;
+  uint8_t path;
+  uint8_t shape;
+  float distance; // leader's distance along the path
+  float speed;    // px per tick
+};
+
+// ============================================================================
+// GAME SNAPSHOT
+// ============================================================================
+
+#define MAX_POOLED_ENTITIES (MAX_ENEMIES + MAX_PLAYER_BULLETS + MAX_ENEMY_BULLETS + \
+                             MAX_POWERUPS + MAX_EXPLOSIONS + MAX_PARTICLES)
+
+// Fixed-point entity record: positions in 1/16 px, velocities in 1/256 px
+struct PackedEntity
+{
+  uint8_t pool;
+  uint8_t slot;
+  uint8_t type;
+  uint8_t animFrame;
+  int16_t x, y;
+  int16_t vx, vy;
+  int16_t health;
+  uint8_t w, h;
+  uint16_t color;
+  uint8_t formation, member;
+};
+static_assert(sizeof(PackedEntity) == 20, "PackedEntity layout is part of the dump format");
+
+struct PackedFormation
+{
+  uint8_t active;
+  uint8_t path;
+  uint8_t shape;
+  uint8_t reserved;
+  int16_t distance; // 1/16 px
+  int16_t speed;    // 1/256 px per tick
+};
+
+// Compact copy of everything Game::update() reads. Timers are stored
+// relative to the capture time so a snapshot can be restored at any clock.
+struct GameSnapshot
+{
+  uint8_t state;
+  uint8_t lives;
+  uint8_t wave;
+  uint8_t weaponLevel;
+  int32_t score;
+  int16_t scrollY;
+  uint16_t count;
+  uint32_t sinceEnemySpawn;
+  uint32_t sincePlayerShot;
+  uint32_t sinceFormation;
+  uint32_t seed;
+  uint32_t stageTick;
+  uint16_t stageCue;
+  uint16_t reserved;
+  uint32_t rng;
+  PackedFormation formations[MAX_FORMATIONS];
+  PackedEntity player;
+  PackedEntity entities[MAX_POOLED_ENTITIES];
+};
+
+// Full-precision entity record for rewind. The packed one rounds position
+// and velocity and drops animation and flash state, so a run restored from
+// it and re-simulated drifts from the one it replaces.
+struct ExactEntity
+{
+  uint8_t active;
+  uint8_t type;
+  uint8_t animClip;
+  uint8_t animTicks;
+  int8_t animDir;
+  uint8_t flashTicks;
+  uint8_t formation;
+  uint8_t member;
+  float x, y, vx, vy;
+  float width, height;
+  int32_t health;
+  uint32_t color;
+  int32_t animFrame;
+};
+static_assert(sizeof(ExactEntity) == 44, "ExactEntity has no padding");
+
+// Everything Game::update() reads, bit for bit: two states compare equal
+// with memcmp exactly when the runs are the same. Built by captureExact()
+// into zeroed memory.
+struct RewindState
+{
+  GameSnapshot snap; // counters, timers and seeds; its entity list is left empty
+  float scrollY;
+  float stageY;
+  float formationDistance[MAX_FORMATIONS];
+  float formationSpeed[MAX_FORMATIONS];
+  uint8_t worldAwake[(WORLD_PLACEMENTS + 31) / 32 * 4];
+  ExactEntity player;
+  ExactEntity entities[MAX_POOLED_ENTITIES]; // every slot of every pool, in pool order
+};
+
 // ============================================================================
 // GAME STATE & ENTITIES
 // ============================================================================
 
+// Raised by Game for stage scripts to wait on (SCRIPT_WAIT_EVENT)
+enum StageEvent : uint32_t
+{
+  EVENT_ENEMY_DOWN = 0x01,
+  EVENT_PLAYER_HIT = 0x02,
+  EVENT_POWERUP = 0x04
+};
+
 class Game
 {
 public:
@@ -437,9 +938,55 @@ public:
   int lives;
   int wave;
   float scrollY;
+  // Distance scrolled into the streamed stage, stageTick * SCROLL_SPEED
+  float stageY = 0;
   unsigned long lastEnemySpawn;
   unsigned long lastPlayerShot;
+  unsigned long lastFormation;
   int playerWeaponLevel;
+  uint32_t seed;
+  uint32_t rng; // the simulation's own random stream, part of snapshots
+  PoolStats poolStats[POOL_COUNT];
+  AabbSoA<MAX_ENEMIES> enemyBoxes;
+  Formation formations[MAX_FORMATIONS];
+  ScriptScheduler<MAX_SCRIPTS, SCRIPT_FRAME_BYTES> scripts;
+  StageGenerator stageGen;
+  uint32_t stageTick; // ticks into the run
+  uint16_t stageCue;  // next cue of the current segment
+  World world;
+  // Pool sizes in use, up to the compiled capacity; 0 = all of it
+  uint16_t poolLimit[POOL_COUNT] = {};
+  // Set once the console has forced spawns or capped a pool: the run's
+  // pool stats no longer show real demand
+  bool tainted = false;
+
+  // Where the game gets its clock and input. The one on screen uses the
+  // globals; an agent environment (ENVIRONMENTS below) gives each of its
+  // games their own and sets headless, which also leaves out sound, the
+  // streamed background and the shared profiler and pool stats.
+  unsigned long *clock = &gameTime;
+  InputSystem *controls = &input;
+  bool headless = false;
+
+  // The stage, started by init(): plays the generated segments' cues as
+  // their ticks come up. Its state is stageTick and stageCue, so a
+  // restored snapshot carries on exactly from a fresh start of the script.
+  struct StageScript : Script
+  {
+    Game *game;
+    explicit StageScript(Game *g) : game(g) {}
+
+    bool resume() override
+    {
+      SCRIPT_BEGIN();
+      for (;;)
+      {
+        SCRIPT_WAIT_UNTIL(game->stageCueDue());
+        game->playStageCue();
+      }
+      SCRIPT_END();
+    }
+  };
 
   enum GameState
   {
@@ -460,10 +1007,26 @@ public:
     playerWeaponLevel = 1;
     lastEnemySpawn = 0;
     lastPlayerShot = 0;
+    lastFormation = *clock;
+    for (int f = 0; f < MAX_FORMATIONS; f++)
+      formations[f].active = false;
+    stageTick = 0;
+    stageCue = 0;
+    stageY = 0;
+    seekBackground();
+
+    tainted = false;
+    for (int p = 0; p < POOL_COUNT; p++)
+    {
+      poolStats[p] = {0, poolCapacity[p], 0};
+      tainted = tainted || poolLimit[p];
+    }
+
+    scripts.clear();
+    scripts.start<StageScript>(this);
 
     // Initialize player
-    player.init(PLAYER, Vec2(SCREEN_WIDTH / 2, SCREEN_HEIGHT - 60),
-                Vec2(0, 0), 24, 24, 100, TFT_CYAN);
+    player.spawn(PLAYER, Vec2(SCREEN_WIDTH / 2, SCREEN_HEIGHT - 60), Vec2(0, 0));
 
     // Deactivate all entities
     for (int i = 0; i < MAX_ENEMIES; i++)
@@ -480,120 +1043,514 @@ public:
       particles[i].active = false;
   }
 
+  // The generated background follows the run's seed. Called before
+  // seekBackground(), which drops the rows read with the old one.
+  void reseedMap(uint32_t runSeed)
+  {
+#if defined(ARDUINO) && PROCEDURAL_MAP
+    if (!headless)
+      proceduralMap.reseed(runSeed);
+#else
+    (void)runSeed;
+#endif
+  }
+
+  // Points the streamed background at stageY, once the stream is running
+  void seekBackground()
+  {
+    if (!headless && background.active())
+      background.seek(stageY);
+  }
+
   void startGame()
   {
+    startGame(esp_random() | 1);
+  }
+
+  // Same seed, same start time and same inputs give the same run
+  void startGame(uint32_t runSeed)
+  {
+    reseedMap(runSeed);
     init();
+    seed = runSeed;
+    rng = seed;
+    stageGen.begin(seed, SCREEN_WIDTH, PATH_COUNT, SHAPE_COUNT);
+    populateWorld();
     state = PLAYING;
   }
 
-  // Entity spawning
-  void spawnEnemy(EntityType type, Vec2 pos, Vec2 vel)
+  Entity *pool(EntityPool p, int &size)
   {
-    for (int i = 0; i < MAX_ENEMIES; i++)
+    switch (p)
     {
-      if (!enemies[i].active)
-      {
-        int hp = 10;
-        uint32_t col = TFT_RED;
-        float w = 20, h = 20;
-
-        switch (type)
-        {
-        case ENEMY_FAST:
-          hp = 5;
-          col = TFT_YELLOW;
-          w = h = 16;
-          break;
-        case ENEMY_TANK:
-          hp = 30;
-          col = TFT_PURPLE;
-          w = h = 28;
-          break;
-        default:
-          break;
-        }
-
-        enemies[i].init(type, pos, vel, w, h, hp, col);
-        break;
-      }
+    case POOL_ENEMIES:
+      size = MAX_ENEMIES;
+      return enemies;
+    case POOL_PLAYER_BULLETS:
+      size = MAX_PLAYER_BULLETS;
+      return playerBullets;
+    case POOL_ENEMY_BULLETS:
+      size = MAX_ENEMY_BULLETS;
+      return enemyBullets;
+    case POOL_POWERUPS:
+      size = MAX_POWERUPS;
+      return powerups;
+    case POOL_EXPLOSIONS:
+      size = MAX_EXPLOSIONS;
+      return explosions;
+    default:
+      size = MAX_PARTICLES;
+      return particles;
     }
   }
 
-  void spawnPlayerBullet(Vec2 pos, Vec2 vel)
+  int activeCount(EntityPool p)
   {
-    for (int i = 0; i < MAX_PLAYER_BULLETS; i++)
-    {
-      if (!playerBullets[i].active)
-      {
-        playerBullets[i].init(BULLET_PLAYER, pos, vel, 4, 8, 1, TFT_WHITE);
-        break;
-      }
-    }
+    int size;
+    Entity *e = pool(p, size);
+    int count = 0;
+    for (int i = 0; i < size; i++)
+      if (e[i].active)
+        count++;
+    return count;
   }
 
-  void spawnEnemyBullet(Vec2 pos, Vec2 vel)
+  // Snapshot / restore
+  static void packEntity(const Entity &e, uint8_t pool, uint8_t slot, PackedEntity &out)
   {
-    for (int i = 0; i < MAX_ENEMY_BULLETS; i++)
+    out.pool = pool;
+    out.slot = slot;
+    out.type = e.type;
+    out.animFrame = e.animFrame;
+    out.x = e.pos.x * 16;
+    out.y = e.pos.y * 16;
+    out.vx = e.vel.x * 256;
+    out.vy = e.vel.y * 256;
+    out.health = e.health;
+    out.w = e.width;
+    out.h = e.height;
+    out.color = e.color;
+    out.formation = e.formation;
+    out.member = e.member;
+  }
+
+  static void unpackEntity(const PackedEntity &in, Entity &e)
+  {
+    e.init((EntityType)in.type, Vec2(in.x / 16.0f, in.y / 16.0f),
+           Vec2(in.vx / 256.0f, in.vy / 256.0f), in.w, in.h, in.health, in.color);
+    if (e.type == EXPLOSION)
+      e.play(CLIP_EXPLOSION);
+    e.animFrame = in.animFrame;
+    if (in.formation < MAX_FORMATIONS && in.member < MAX_FORMATION_MEMBERS)
     {
-      if (!enemyBullets[i].active)
-      {
-        enemyBullets[i].init(BULLET_ENEMY, pos, vel, 4, 8, 1, TFT_ORANGE);
-        break;
-      }
+      e.formation = in.formation;
+      e.member = in.member;
     }
   }
 
-  void spawnExplosion(Vec2 pos, float size)
+  void capture(GameSnapshot &snap)
   {
-    for (int i = 0; i < MAX_EXPLOSIONS; i++)
+    snap.state = state;
+    snap.lives = lives;
+    snap.wave = wave;
+    snap.weaponLevel = playerWeaponLevel;
+    snap.score = score;
+    snap.scrollY = scrollY * 16;
+    snap.sinceEnemySpawn = *clock - lastEnemySpawn;
+    snap.sincePlayerShot = *clock - lastPlayerShot;
+    snap.sinceFormation = *clock - lastFormation;
+    snap.seed = seed;
+    snap.stageTick = stageTick;
+    snap.stageCue = stageCue;
+    snap.reserved = 0;
+    snap.rng = rng;
+    for (int f = 0; f < MAX_FORMATIONS; f++)
     {
-      if (!explosions[i].active)
-      {
-        explosions[i].init(EXPLOSION, pos, Vec2(0, 0), size, size, 6, TFT_ORANGE);
-        break;
-      }
+      PackedFormation &pf = snap.formations[f];
+      pf.active = formations[f].active;
+      pf.path = formations[f].path;
+      pf.shape = formations[f].shape;
+      pf.reserved = 0;
+      pf.distance = formations[f].distance * 16;
+      pf.speed = formations[f].speed * 256;
     }
+    packEntity(player, 0xFF, 0, snap.player);
 
-    // Spawn particles
-    for (int j = 0; j < 8; j++)
+    uint16_t n = 0;
+    for (int p = 0; p < POOL_COUNT; p++)
     {
-      float angle = (j / 8.0) * 2 * PI;
-      Vec2 vel(cos(angle) * 2, sin(angle) * 2);
-      spawnParticle(pos, vel);
+      int size;
+      Entity *e = pool((EntityPool)p, size);
+      for (int i = 0; i < size; i++)
+        if (e[i].active)
+          packEntity(e[i], p, i, snap.entities[n++]);
     }
+    snap.count = n;
   }
 
-  void spawnParticle(Vec2 pos, Vec2 vel)
+  static void saveExact(const Entity &e, ExactEntity &out)
   {
-    for (int i = 0; i < MAX_PARTICLES; i++)
-    {
-      if (!particles[i].active)
-      {
-        particles[i].init(PARTICLE, pos, vel, 2, 2, 10, TFT_YELLOW);
-        break;
-      }
-    }
+    if (!e.active)
+      return; // left zeroed, so free slots compare equal
+    out.active = 1;
+    out.type = e.type;
+    out.animClip = e.animClip;
+    out.animTicks = e.animTicks;
+    out.animDir = e.animDir;
+    out.flashTicks = e.flashTicks;
+    out.formation = e.formation;
+    out.member = e.member;
+    out.x = e.pos.x;
+    out.y = e.pos.y;
+    out.vx = e.vel.x;
+    out.vy = e.vel.y;
+    out.width = e.width;
+    out.height = e.height;
+    out.health = e.health;
+    out.color = e.color;
+    out.animFrame = e.animFrame;
   }
 
-  void spawnPowerup(Vec2 pos, EntityType type)
+  static void loadExact(const ExactEntity &in, Entity &e)
   {
-    for (int i = 0; i < MAX_POWERUPS; i++)
-    {
-      if (!powerups[i].active)
-      {
-        uint32_t col = type == POWERUP_WEAPON ? TFT_GREEN : TFT_MAGENTA;
-        powerups[i].init(type, pos, Vec2(0, 1), 16, 16, 1, col);
-        break;
-      }
-    }
+    e.active = in.active != 0;
+    if (!e.active)
+      return;
+    e.type = (EntityType)in.type;
+    e.pos = Vec2(in.x, in.y);
+    e.vel = Vec2(in.vx, in.vy);
+    e.width = in.width;
+    e.height = in.height;
+    e.health = in.health;
+    e.color = in.color;
+    e.animFrame = in.animFrame;
+    e.animClip = in.animClip;
+    e.animTicks = in.animTicks;
+    e.animDir = in.animDir;
+    e.flashTicks = in.flashTicks;
+    e.formation = in.formation;
+    e.member = in.member;
   }
 
-  // Update functions
-  void update()
+  // state must be zeroed first
+  void captureExact(RewindState &state)
   {
-    if (state == TITLE)
+    capture(state.snap);
+    state.snap.count = 0;
+    memset(state.snap.entities, 0, sizeof(state.snap.entities));
+    state.scrollY = scrollY;
+    state.stageY = stageY;
+    for (int f = 0; f < MAX_FORMATIONS; f++)
     {
-      if (input.getTouching())
+      state.formationDistance[f] = formations[f].distance;
+      state.formationSpeed[f] = formations[f].speed;
+    }
+    world.saveAwake(state.worldAwake, sizeof(state.worldAwake));
+    saveExact(player, state.player);
+    int n = 0;
+    for (int p = 0; p < POOL_COUNT; p++)
+    {
+      int size;
+      Entity *e = pool((EntityPool)p, size);
+      for (int i = 0; i < size; i++)
+        saveExact(e[i], state.entities[n++]);
+    }
+  }
+
+  // restore() for the fields the snapshot rounds, then the rest exactly
+  void restoreExact(const RewindState &state)
+  {
+    restore(state.snap);
+    scrollY = state.scrollY;
+    stageY = state.stageY;
+    seekBackground();
+    for (int f = 0; f < MAX_FORMATIONS; f++)
+    {
+      formations[f].distance = state.formationDistance[f];
+      formations[f].speed = state.formationSpeed[f];
+    }
+    world.loadAwake(state.worldAwake, sizeof(state.worldAwake));
+    loadExact(state.player, player);
+    int n = 0;
+    for (int p = 0; p < POOL_COUNT; p++)
+    {
+      int size;
+      Entity *e = pool((EntityPool)p, size);
+      for (int i = 0; i < size; i++)
+        loadExact(state.entities[n++], e[i]);
+    }
+  }
+
+  void restore(const GameSnapshot &snap)
+  {
+    init();
+    state = (GameState)snap.state;
+    lives = snap.lives;
+    wave = snap.wave;
+    playerWeaponLevel = snap.weaponLevel;
+    score = snap.score;
+    scrollY = snap.scrollY / 16.0f;
+    lastEnemySpawn = *clock - snap.sinceEnemySpawn;
+    lastPlayerShot = *clock - snap.sincePlayerShot;
+    lastFormation = *clock - snap.sinceFormation;
+    seed = snap.seed;
+    stageGen.begin(seed, SCREEN_WIDTH, PATH_COUNT, SHAPE_COUNT);
+    stageTick = snap.stageTick;
+    stageCue = snap.stageCue;
+    stageY = stageTick * SCROLL_SPEED;
+    reseedMap(seed);
+    seekBackground();
+    rng = snap.rng;
+    populateWorld();
+    // Whatever the last tick's wake window reached is already out
+    if (stageTick)
+      world.wakeBelow((stageTick - 1) * SCROLL_SPEED + SCREEN_HEIGHT + WAKE_MARGIN);
+    for (int f = 0; f < MAX_FORMATIONS; f++)
+    {
+      const PackedFormation &pf = snap.formations[f];
+      formations[f] = {pf.active != 0 && pf.path < PATH_COUNT && pf.shape < SHAPE_COUNT,
+                       pf.path, pf.shape, pf.distance / 16.0f, pf.speed / 256.0f};
+    }
+    unpackEntity(snap.player, player);
+
+    for (int n = 0; n < snap.count; n++)
+    {
+      const PackedEntity &pe = snap.entities[n];
+      int size;
+      Entity *e = pool((EntityPool)pe.pool, size);
+      if (pe.pool < POOL_COUNT && pe.slot < size)
+        unpackEntity(pe, e[pe.slot]);
+    }
+  }
+
+  // Entity spawning
+
+  // Returns a free slot in the pool, or nullptr (and counts the overflow)
+  Entity *allocate(EntityPool p)
+  {
+    int size;
+    Entity *e = pool(p, size);
+    if (poolLimit[p] && poolLimit[p] < size)
+      size = poolLimit[p];
+    for (int i = 0; i < size; i++)
+      if (!e[i].active)
+        return &e[i];
+    poolStats[p].overflows++;
+    return nullptr;
+  }
+
+  void trackPoolUsage()
+  {
+    for (int p = 0; p < POOL_COUNT; p++)
+    {
+      uint16_t n = activeCount((EntityPool)p);
+      if (n > poolStats[p].highWater)
+        poolStats[p].highWater = n;
+    }
+  }
+
+  void spawnEnemy(EntityType type, Vec2 pos, Vec2 vel)
+  {
+    Entity *e = allocate(POOL_ENEMIES);
+    if (e)
+      e->spawn(type, pos, vel);
+  }
+
+  // Launches every member of shape at the start of path. Members the enemy
+  // pool has no room for are left out. Returns the formation, or -1.
+  int startFormation(EntityType type, PathId path, ShapeId shape)
+  {
+    lastFormation = *clock;
+    int f = 0;
+    while (f < MAX_FORMATIONS && formations[f].active)
+      f++;
+    if (f == MAX_FORMATIONS)
+      return -1;
+
+    // Twice the type's free-flying speed, to cross the screen in a few seconds
+    formations[f] = {true, (uint8_t)path, (uint8_t)shape, 0.0f, archetypes[type].speed * 2};
+    const FormationShape &fs = formationShapes[shape];
+    for (int m = 0; m < fs.count; m++)
+    {
+      Entity *e = allocate(POOL_ENEMIES);
+      if (!e)
+        break;
+      PathPoint p = paths[path].at(-fs.lag[m]);
+      e->spawn(type, Vec2(p.x + fs.dx[m], p.y + fs.dy[m]), Vec2(0, 0));
+      e->formation = f;
+      e->member = m;
+    }
+    return f;
+  }
+
+  // Moves every formation along its path and places the members on it.
+  // A formation with no members left is over.
+  void updateFormations()
+  {
+    uint8_t live[MAX_FORMATIONS] = {};
+    for (int f = 0; f < MAX_FORMATIONS; f++)
+      if (formations[f].active)
+        formations[f].distance += formations[f].speed;
+
+    for (int i = 0; i < MAX_ENEMIES; i++)
+    {
+      Entity &e = enemies[i];
+      if (!e.active || e.formation == NO_FORMATION)
+        continue;
+      const Formation &f = formations[e.formation];
+      const FormationShape &fs = formationShapes[f.shape];
+      PathPoint p = paths[f.path].at(f.distance - fs.lag[e.member]);
+      Vec2 next(p.x + fs.dx[e.member], p.y + fs.dy[e.member]);
+      e.vel = next - e.pos;
+      e.pos = next;
+      live[e.formation] = 1;
+    }
+
+    for (int f = 0; f < MAX_FORMATIONS; f++)
+      if (!live[f])
+        formations[f].active = false;
+  }
+
+  // lo .. hi - 1 from the run's random stream. Kept in Game rather than
+  // Arduino's random() so a snapshot carries it and a restored run plays
+  // out the same.
+  long roll(long lo, long hi)
+  {
+    rng = mix32(rng);
+    return hi > lo ? lo + (long)(rng % (uint32_t)(hi - lo)) : lo;
+  }
+
+  // World
+
+  // Bottom of the screen in world coordinates
+  int32_t cameraY() const { return stageTick * SCROLL_SPEED; }
+
+  // Tank emplacements and the odd powerup along the run, from the seed
+  // Without the memory for it the run just has no placed entities
+  void populateWorld()
+  {
+    if (!world.begin(SCREEN_WIDTH, WORLD_HEIGHT, WORLD_PLACEMENTS))
+    {
+      world.release();
+      return;
+    }
+    uint32_t rng = mix32(seed ^ 0x574F524C); // "WORL"
+    for (int i = 0; i < WORLD_PLACEMENTS; i++)
+    {
+      uint32_t x = 30 + (rng = mix32(rng)) % (SCREEN_WIDTH - 60);
+      uint32_t y = SCREEN_HEIGHT + (rng = mix32(rng)) % (WORLD_HEIGHT - SCREEN_HEIGHT);
+      uint32_t roll = (rng = mix32(rng)) % 100;
+      EntityType type = roll < 80 ? ENEMY_TANK : roll < 90 ? POWERUP_WEAPON : POWERUP_HEALTH;
+      world.place(type, x, y);
+    }
+    if (!world.finish())
+      world.release();
+  }
+
+  // Spawns whatever the camera is about to reach, just above the screen
+  void wakeWorld()
+  {
+    int32_t cam = cameraY();
+    world.activate(0, cam + SCREEN_HEIGHT, SCREEN_WIDTH, cam + SCREEN_HEIGHT + WAKE_MARGIN,
+                   [this, cam](uint8_t type, int32_t x, int32_t y, uint8_t) {
+                     Vec2 pos(x, SCREEN_HEIGHT - (y - cam));
+                     const Archetype &a = archetypes[type];
+                     Entity *e = allocate(type == ENEMY_TANK ? POOL_ENEMIES : POOL_POWERUPS);
+                     if (!e)
+                       return false;
+                     e->spawn((EntityType)type, pos, Vec2(0, a.speed));
+                     return true;
+                   });
+  }
+
+  // Stage cues
+
+  bool stageCueDue()
+  {
+    const StageSegment &s = stageGen.segment(stageTick / SEGMENT_TICKS);
+    return stageCue < s.cueCount && s.cues[stageCue].tick <= stageTick % SEGMENT_TICKS;
+  }
+
+  void playStageCue()
+  {
+    const StageCue &c = stageGen.segment(stageTick / SEGMENT_TICKS).cues[stageCue++];
+    EntityType enemy = (EntityType)(ENEMY_BASIC + min((int)c.variant, 2));
+    switch (c.kind)
+    {
+    case CUE_ENEMY:
+      spawnEnemy(enemy, Vec2(c.x, -20), Vec2(0, archetypes[enemy].speed));
+      lastEnemySpawn = *clock;
+      break;
+    case CUE_FORMATION:
+      startFormation(enemy, (PathId)(c.path % PATH_COUNT), (ShapeId)(c.shape % SHAPE_COUNT));
+      break;
+    case CUE_POWERUP:
+      spawnPowerup(Vec2(c.x, -20), c.variant ? POWERUP_HEALTH : POWERUP_WEAPON);
+      break;
+    }
+  }
+
+  void spawnPlayerBullet(Vec2 pos, Vec2 vel)
+  {
+    Entity *e = allocate(POOL_PLAYER_BULLETS);
+    if (e)
+      e->spawn(BULLET_PLAYER, pos, vel);
+  }
+
+  void spawnEnemyBullet(Vec2 pos, Vec2 vel)
+  {
+    Entity *e = allocate(POOL_ENEMY_BULLETS);
+    if (e)
+      e->spawn(BULLET_ENEMY, pos, vel);
+  }
+
+  void spawnExplosion(Vec2 pos, float size)
+  {
+    Entity *e = allocate(POOL_EXPLOSIONS);
+    if (e)
+    {
+      e->spawn(EXPLOSION, pos, Vec2(0, 0));
+      e->width = e->height = size;
+      e->play(CLIP_EXPLOSION);
+    }
+
+    // Spawn particles
+    for (int j = 0; j < 8; j++)
+    {
+      float angle = (j / 8.0) * 2 * PI;
+      Vec2 vel(cos(angle) * archetypes[PARTICLE].speed, sin(angle) * archetypes[PARTICLE].speed);
+      spawnParticle(pos, vel);
+    }
+  }
+
+  void spawnParticle(Vec2 pos, Vec2 vel)
+  {
+    Entity *e = allocate(POOL_PARTICLES);
+    if (e)
+      e->spawn(PARTICLE, pos, vel);
+  }
+
+  void spawnPowerup(Vec2 pos, EntityType type)
+  {
+    Entity *e = allocate(POOL_POWERUPS);
+    if (e)
+      e->spawn(type, pos, Vec2(0, archetypes[type].speed));
+  }
+
+  void playSound(SoundSystem::SoundEffect effect)
+  {
+    if (!headless)
+      sound.play(effect);
+  }
+
+  // Update functions
+  void update()
+  {
+    *clock += FRAME_TIME;
+
+    if (state == TITLE)
+    {
+      if (controls->getTouching())
       {
         startGame();
       }
@@ -602,7 +1559,7 @@ public:
 
     if (state == GAME_OVER)
     {
-      if (input.getTouching())
+      if (controls->getTouching())
       {
         startGame();
       }
@@ -610,37 +1567,29 @@ public:
     }
 
     // Update scroll
-    scrollY += 1.0;
+    scrollY += SCROLL_SPEED;
     if (scrollY > 32)
       scrollY = 0;
+    stageY += SCROLL_SPEED;
+    if (!headless && background.active())
+      background.advance(stageY, SCROLL_SPEED);
 
     // Update player
     updatePlayer();
 
-    // Spawn enemies
-    if (millis() - lastEnemySpawn > 2000)
+    // Stage scripts spawn the enemies
+    if (stageTick % SEGMENT_TICKS == 0)
     {
-      int enemyType = random(0, 100);
-      EntityType type = ENEMY_BASIC;
-      float speed = 1.5;
-
-      if (enemyType > 70)
-      {
-        type = ENEMY_FAST;
-        speed = 3.0;
-      }
-      else if (enemyType > 90)
-      {
-        type = ENEMY_TANK;
-        speed = 0.8;
-      }
-
-      float x = random(30, SCREEN_WIDTH - 30);
-      spawnEnemy(type, Vec2(x, -20), Vec2(0, speed));
-      lastEnemySpawn = millis();
+      stageCue = 0;
+      wave = stageTick / SEGMENT_TICKS + 1;
     }
+    scripts.step();
+    wakeWorld();
+    stageTick++;
+    stageGen.step(GEN_SLICE_US);
 
     // Update enemies
+    updateFormations();
     updateEnemies();
 
     // Update bullets
@@ -658,17 +1607,21 @@ public:
     // Check collisions
     checkCollisions();
 
+    trackPoolUsage();
+
     // Check game over
     if (lives <= 0)
     {
       state = GAME_OVER;
+      if (!headless)
+        poolStore.recordRun(poolStats, tainted);
     }
   }
 
   void updatePlayer()
   {
-    Vec2 movement = input.getMovement();
-    player.vel = movement * 10.0;
+    Vec2 movement = controls->getMovement();
+    player.vel = movement * archetypes[PLAYER].speed;
     player.pos = player.pos + player.vel;
 
     // Clamp to screen
@@ -676,27 +1629,28 @@ public:
     player.pos.y = constrain(player.pos.y, player.height / 2, SCREEN_HEIGHT - player.height / 2 - 100);
 
     // Shooting
-    if (input.isFirePressed() && millis() - lastPlayerShot > 150)
+    if (controls->isFirePressed() && *clock - lastPlayerShot > 150)
     {
-      sound.play(SoundSystem::SHOOT);
+      playSound(SoundSystem::SHOOT);
 
+      float v = archetypes[BULLET_PLAYER].speed;
       if (playerWeaponLevel == 1)
       {
-        spawnPlayerBullet(player.pos, Vec2(0, -8));
+        spawnPlayerBullet(player.pos, Vec2(0, -v));
       }
       else if (playerWeaponLevel == 2)
       {
-        spawnPlayerBullet(player.pos + Vec2(-8, 0), Vec2(0, -8));
-        spawnPlayerBullet(player.pos + Vec2(8, 0), Vec2(0, -8));
+        spawnPlayerBullet(player.pos + Vec2(-8, 0), Vec2(0, -v));
+        spawnPlayerBullet(player.pos + Vec2(8, 0), Vec2(0, -v));
       }
       else
       {
-        spawnPlayerBullet(player.pos, Vec2(0, -8));
-        spawnPlayerBullet(player.pos + Vec2(-8, 0), Vec2(-1, -8));
-        spawnPlayerBullet(player.pos + Vec2(8, 0), Vec2(1, -8));
+        spawnPlayerBullet(player.pos, Vec2(0, -v));
+        spawnPlayerBullet(player.pos + Vec2(-8, 0), Vec2(-1, -v));
+        spawnPlayerBullet(player.pos + Vec2(8, 0), Vec2(1, -v));
       }
 
-      lastPlayerShot = millis();
+      lastPlayerShot = *clock;
     }
   }
 
@@ -707,11 +1661,20 @@ public:
       if (!enemies[i].active)
         continue;
 
+      if (enemies[i].flashTicks)
+        enemies[i].flashTicks--;
+
       // enemies[i].pos = enemies[i].pos + enemies[i].vel;
 
-      Vec2 dir = (player.pos - enemies[i].pos).normalize();        
-      enemies[i].pos.x = enemies[i].pos.x + dir.x * enemies[i].vel.y * 1.5;
-      enemies[i].pos.y = enemies[i].pos.y + enemies[i].vel.y;
+      // Steer towards the player; vel.x keeps the sideways part so the
+      // renderer can face the ship along its actual heading. Formation
+      // members were already placed by updateFormations().
+      if (enemies[i].formation == NO_FORMATION)
+      {
+        Vec2 dir = (player.pos - enemies[i].pos).normalize();
+        enemies[i].vel.x = dir.x * enemies[i].vel.y * 1.5;
+        enemies[i].pos = enemies[i].pos + enemies[i].vel;
+      }
 
       // Remove if off screen
       if (enemies[i].pos.y > SCREEN_HEIGHT + 20)
@@ -721,13 +1684,13 @@ public:
       }
 
       // Enemy shooting
-      if (random(0, 100) < 2)
+      if (roll(0, 100) < 2)
       {
         // Vec2 dir = (player.pos - enemies[i].pos).normalize();
         // spawnEnemyBullet(enemies[i].pos, dir * 3.0);
 
-        spawnEnemyBullet(enemies[i].pos, Vec2(0, 3));
-        sound.play(SoundSystem::ENEMY_SHOOT);
+        spawnEnemyBullet(enemies[i].pos, Vec2(0, archetypes[BULLET_ENEMY].speed));
+        playSound(SoundSystem::ENEMY_SHOOT);
       }
     }
   }
@@ -769,21 +1732,10 @@ public:
 
   void updateExplosions()
   {
+    animateEntities(explosions, MAX_EXPLOSIONS);
     for (int i = 0; i < MAX_EXPLOSIONS; i++)
-    {
-      if (!explosions[i].active)
-        continue;
-
-      if (millis() - explosions[i].lastAnimTime > 50)
-      {
-        explosions[i].animFrame++;
-        explosions[i].lastAnimTime = millis();
-        if (explosions[i].animFrame >= explosions[i].health)
-        {
-          explosions[i].deactivate();
-        }
-      }
-    }
+      if (explosions[i].active && !explosions[i].animating())
+        explosions[i].deactivate();
   }
 
   void updateParticles()
@@ -801,42 +1753,56 @@ public:
 
   void checkCollisions()
   {
-    // Player bullets vs enemies
-    for (int i = 0; i < MAX_PLAYER_BULLETS; i++)
+    uint32_t tests = 0;
+
+    // Player bullets vs enemies: enemy boxes go into SoA form once, then
+    // each bullet is tested against all of them in one kernel call
+    int live = 0;
+    enemyBoxes.clear();
+    for (int j = 0; j < MAX_ENEMIES; j++)
+    {
+      if (!enemies[j].active)
+        continue;
+      Rect r = enemies[j].hitbox();
+      enemyBoxes.set(j, r.x, r.y, r.x + r.w, r.y + r.h);
+      live++;
+    }
+
+    for (int i = 0; i < MAX_PLAYER_BULLETS && live; i++)
     {
       if (!playerBullets[i].active)
         continue;
 
-      for (int j = 0; j < MAX_ENEMIES; j++)
+      tests += live;
+      Rect b = playerBullets[i].hitbox();
+      uint32_t hits = overlap(enemyBoxes, b.x, b.y, b.x + b.w, b.y + b.h);
+      if (hits)
       {
-        if (!enemies[j].active)
-          continue;
+        // Lowest index first, as the pairwise loop did
+        int j = __builtin_ctz(hits);
+        playerBullets[i].deactivate();
+        enemies[j].health -= 10;
 
-        if (playerBullets[i].getRect().intersects(enemies[j].getRect()))
+        if (enemies[j].health <= 0)
         {
-          playerBullets[i].deactivate();
-          enemies[j].health -= 10;
-
-          if (enemies[j].health <= 0)
-          {
-            score += 100;
-            spawnExplosion(enemies[j].pos, enemies[j].width);
-            sound.play(SoundSystem::EXPLOSION);
-
-            // Chance to drop powerup
-            if (random(0, 100) < 20)
-            {
-              EntityType pType = random(0, 2) == 0 ? POWERUP_WEAPON : POWERUP_HEALTH;
-              spawnPowerup(enemies[j].pos, pType);
-            }
-
-            enemies[j].deactivate();
-          }
-          else
-          {
-            sound.play(SoundSystem::HIT);
-          }
-          break;
+          const Archetype &a = archetypes[enemies[j].type];
+          score += a.score;
+          spawnExplosion(enemies[j].pos, enemies[j].width);
+          playSound(SoundSystem::EXPLOSION);
+
+          // Chance to drop powerup
+          if (a.drops.count && roll(0, 100) < a.drops.chance)
+            spawnPowerup(enemies[j].pos, a.drops.items[roll(0, a.drops.count)]);
+
+          enemies[j].deactivate();
+          enemyBoxes.remove(j);
+          scripts.signal(EVENT_ENEMY_DOWN);
+          live--;
+        }
+        else
+        {
+          enemies[j].flashTicks = HIT_FLASH_TICKS;
+          playSound(SoundSystem::HIT);
         }
       }
     }
@@ -847,12 +1813,14 @@ public:
       if (!enemyBullets[i].active)
         continue;
 
-      if (enemyBullets[i].getRect().intersects(player.getRect()))
+      tests++;
+      if (enemyBullets[i].hitbox().intersects(player.hitbox()))
       {
         enemyBullets[i].deactivate();
         lives--;
+        scripts.signal(EVENT_PLAYER_HIT);
         spawnExplosion(player.pos, player.width);
-        sound.play(SoundSystem::HIT);
+        playSound(SoundSystem::HIT);
       }
     }
 
@@ -862,13 +1830,15 @@ public:
       if (!enemies[i].active)
         continue;
 
-      if (enemies[i].getRect().intersects(player.getRect()))
+      tests++;
+      if (enemies[i].hitbox().intersects(player.hitbox()))
       {
         lives--;
         spawnExplosion(enemies[i].pos, enemies[i].width);
         spawnExplosion(player.pos, player.width);
-        sound.play(SoundSystem::EXPLOSION);
+        playSound(SoundSystem::EXPLOSION);
         enemies[i].deactivate();
+        scripts.signal(EVENT_ENEMY_DOWN | EVENT_PLAYER_HIT);
       }
     }
 
@@ -878,7 +1848,8 @@ public:
       if (!powerups[i].active)
         continue;
 
-      if (powerups[i].getRect().intersects(player.getRect()))
+      tests++;
+      if (powerups[i].hitbox().intersects(player.hitbox()))
       {
         if (powerups[i].type == POWERUP_WEAPON)
         {
@@ -888,16 +1859,25 @@ public:
         {
           lives = min(lives + 1, 5);
         }
-        sound.play(SoundSystem::POWERUP);
+        playSound(SoundSystem::POWERUP);
         powerups[i].deactivate();
+        scripts.signal(EVENT_POWERUP);
       }
     }
+
+    if (!headless)
+      profiler.count(COUNT_COLLISION_TESTS, tests);
   }
 
   // Rendering
-  void render()
+  // present = false leaves the frame in the canvas, for headless runs
+  void render(bool present = true)
   {
+    profiler.begin(SPAN_DRAW);
+    overdraw.beginFrame();
     canvas.fillSprite(TFT_BLACK);
+    profiler.count(COUNT_PIXELS_DRAWN, SCREEN_WIDTH * SCREEN_HEIGHT);
+    overdraw.add(OD_CLEAR, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
 
     if (state == TITLE)
     {
@@ -911,8 +1891,15 @@ public:
     {
       renderGameOver();
     }
+    profiler.end(SPAN_DRAW);
+    overdraw.endFrame();
+    if (!present)
+      return;
 
+    profiler.begin(SPAN_PUSH);
     canvas.pushSprite(0, 0);
+    profiler.end(SPAN_PUSH);
+    profiler.count(COUNT_BYTES_FLUSHED, SCREEN_WIDTH * SCREEN_HEIGHT * 2);
   }
 
   void renderTitle()
@@ -949,6 +1936,8 @@ public:
 
   void renderGame()
   {
+    classifyVisibility();
+
     // Draw scrolling background
     drawBackground();
 
@@ -963,10 +1952,86 @@ public:
     // Draw UI
     drawHUD();
     input.drawUI();
+    if (settings.overlay)
+      drawOverlay();
+  }
+
+  // Last frame's total and this frame's spans so far, top right
+  void drawOverlay()
+  {
+    char text[24];
+    canvas.setTextColor(TFT_GREEN, TFT_BLACK);
+    canvas.setTextDatum(TR_DATUM);
+    canvas.setTextSize(1);
+    snprintf(text, sizeof(text), "frame %uus", profiler.frame());
+    canvas.drawString(text, SCREEN_WIDTH - 4, 4);
+    for (int s = 0; s < SPAN_COUNT; s++)
+    {
+      snprintf(text, sizeof(text), "%s %uus", FrameProfiler::spanName((ProfileSpan)s), profiler.span((ProfileSpan)s));
+      canvas.drawString(text, SCREEN_WIDTH - 4, 14 + s * 10);
+    }
+  }
+
+  // Draw box of an entity in screen pixels, the same one its draw code uses
+  static uint8_t classify(const Entity &e)
+  {
+    const Archetype &a = archetypes[e.type];
+    int x = e.pos.x - a.width / 2.0f;
+    int y = e.pos.y - a.height / 2.0f;
+    if (x >= SCREEN_WIDTH || y >= SCREEN_HEIGHT || x + a.width <= 0 || y + a.height <= 0)
+      return VIS_CULLED;
+    if (x >= 0 && y >= 0 && x + a.width <= SCREEN_WIDTH && y + a.height <= SCREEN_HEIGHT)
+      return VIS_VISIBLE;
+    return VIS_PARTIAL;
+  }
+
+  void classifyVisibility()
+  {
+    uint32_t culled = 0;
+    for (int p = 0; p < POOL_COUNT; p++)
+    {
+      int size;
+      Entity *e = pool((EntityPool)p, size);
+      for (int i = 0; i < size; i++)
+      {
+        if (!e[i].active)
+          continue;
+        e[i].visibility = classify(e[i]);
+        if (e[i].visibility == VIS_CULLED)
+          culled++;
+      }
+    }
+    player.visibility = classify(player);
+    profiler.count(COUNT_CULLED, culled);
+  }
+
+  // Sprite draw that takes the unclipped path when the sprite is fully on
+  // screen. Tested on the sprite's own box, not the entity's visibility:
+  // the art being drawn need not match the archetype's size.
+  void drawSprite(const Entity &e, int x, int y, int w, int h, const uint16_t *pixels)
+  {
+    overdraw.add(e.type == EXPLOSION ? OD_EFFECTS : OD_SPRITES, x, y, w, h);
+    bool inside = x >= 0 && y >= 0 && x + w <= SCREEN_WIDTH && y + h <= SCREEN_HEIGHT;
+    if (inside && settings.fastBlits)
+    {
+      blitUnclipped(canvas, x, y, w, h, pixels);
+      profiler.count(COUNT_FAST_DRAWS);
+    }
+    else
+      canvas.pushImage(x, y, w, h, pixels);
+    profiler.count(COUNT_PIXELS_DRAWN, w * h);
   }
 
   void drawBackground()
   {
+    if (settings.quality == 0)
+      return;
+    if (background.active() && settings.quality >= 2)
+    {
+      drawStage();
+      return;
+    }
+
     // Simple star field
     for (int y = -32; y < SCREEN_HEIGHT; y += 32)
     {
@@ -974,10 +2039,30 @@ public:
       {
         int starY = (int)(y + scrollY) % SCREEN_HEIGHT;
         canvas.fillCircle(x + (y / 32) * 20, starY, 1, TFT_DARKGREY);
+        overdraw.addCircle(OD_BACKGROUND, x + (y / 32) * 20, starY, 1);
       }
     }
   }
 
+  // Tile rows from the streamer; a row that has not arrived is left black
+  void drawStage()
+  {
+    int ts = background.tileSize();
+    uint32_t first = (uint32_t)stageY / ts;
+    int offset = (int)stageY % ts;
+    for (int k = 0; k <= background.visibleRows(); k++)
+    {
+      const uint8_t *tiles = background.row(first + k);
+      if (!tiles)
+        continue;
+      int y = SCREEN_HEIGHT - (k + 1) * ts + offset;
+      for (int c = 0; c < background.columns(); c++)
+        canvas.pushImage(c * ts, y, ts, ts, background.tile(tiles[c]));
+      overdraw.add(OD_BACKGROUND, 0, y, background.columns() * ts, ts);
+      profiler.count(COUNT_PIXELS_DRAWN, background.columns() * ts * ts);
+    }
+  }
+
   void drawPlayer()
   {
     // Simple triangle ship (placeholder for your pixel art)
@@ -996,81 +2081,78 @@ public:
 
     int x = player.pos.x - player.width / 2;
     int y = player.pos.y - player.height / 2;
-    canvas.pushImage(x, y, 24, 24, player_ship_map);
+    // Bank one heading step into sideways movement (the art faces up)
+    const SpriteInfo &s = spriteCache.get(SPRITE_PLAYER);
+    int bank = player.vel.x > 5 ? 1 : player.vel.x < -5 ? -1 : 0;
+    const uint16_t *pixels = rotations.variant(SPRITE_PLAYER, bank);
+    drawSprite(player, x, y, s.width, s.height, pixels ? pixels : s.pixels);
   }
 
   void drawEnemies()
   {
     for (int i = 0; i < MAX_ENEMIES; i++)
     {
-      if (!enemies[i].active)
+      if (!enemies[i].active || enemies[i].visibility == VIS_CULLED)
         continue;
 
       int x = enemies[i].pos.x - enemies[i].width / 2;
       int y = enemies[i].pos.y - enemies[i].height / 2;
 
-      // Choose sprite based on enemy type
-      const uint16_t *sprite;
-      int w, h;
-
-      switch (enemies[i].type)
+      SpriteId id = archetypes[enemies[i].type].sprite;
+      const SpriteInfo &s = spriteCache.get(id);
+      const uint16_t *pixels = rotations.variant(id, RotationCache::stepFor(enemies[i].vel.x, enemies[i].vel.y));
+      if (!pixels)
+        pixels = s.pixels;
+      if (enemies[i].flashTicks)
       {
-      case ENEMY_BASIC:
-        sprite = enemy_basic_map;
-        w = h = 20;
-        break;
-      case ENEMY_FAST:
-        sprite = enemy_fast_map;
-        w = h = 16;
-        break;
-      case ENEMY_TANK:
-        sprite = enemy_tank_map;
-        w = h = 28;
-        break;
+        profiler.count(COUNT_PIXELS_DRAWN, blitImage(canvas, x, y, s.width, s.height, pixels, 0, &hitFlash));
+        overdraw.add(OD_SPRITES, x, y, s.width, s.height);
       }
-
-      canvas.pushImage(x, y, w, h, sprite);
+      else
+        drawSprite(enemies[i], x, y, s.width, s.height, pixels);
     }
   }
 
   void drawBullets()
   {
-    // Player bullets
+    // Both pinned, so neither lookup can evict the other
+    const SpriteInfo &playerBullet = spriteCache.get(SPRITE_BULLET_PLAYER);
+    const SpriteInfo &enemyBullet = spriteCache.get(SPRITE_BULLET_ENEMY);
+
+    // Each kind is queued, then drawn in one pass from its row spans
+    playerBulletBatch.clear();
     for (int i = 0; i < MAX_PLAYER_BULLETS; i++)
-    {
-      if (!playerBullets[i].active)
-        continue;
-      int x = playerBullets[i].pos.x - 2;
-      int y = playerBullets[i].pos.y - 4;
-      canvas.pushImage(x, y, 4, 8, bullet_player_map);
-    }
+      if (playerBullets[i].active && playerBullets[i].visibility != VIS_CULLED)
+      {
+        playerBulletBatch.add(playerBullets[i].pos.x - 2, playerBullets[i].pos.y - 4);
+        overdraw.add(OD_BULLETS, playerBullets[i].pos.x - 2, playerBullets[i].pos.y - 4, playerBullet.width,
+                     playerBullet.height, playerBulletBatch.opaquePixels());
+      }
+    profiler.count(COUNT_PIXELS_DRAWN, playerBulletBatch.draw(canvas, playerBullet.pixels));
 
-    // Enemy bullets
+    enemyBulletBatch.clear();
     for (int i = 0; i < MAX_ENEMY_BULLETS; i++)
-    {
-      if (!enemyBullets[i].active)
-        continue;
-      int x = enemyBullets[i].pos.x - 2;
-      int y = enemyBullets[i].pos.y - 4;
-      canvas.pushImage(x, y, 4, 8, bullet_enemy_map);
-    }
+      if (enemyBullets[i].active && enemyBullets[i].visibility != VIS_CULLED)
+      {
+        enemyBulletBatch.add(enemyBullets[i].pos.x - 2, enemyBullets[i].pos.y - 4);
+        overdraw.add(OD_BULLETS, enemyBullets[i].pos.x - 2, enemyBullets[i].pos.y - 4, enemyBullet.width,
+                     enemyBullet.height, enemyBulletBatch.opaquePixels());
+      }
+    profiler.count(COUNT_PIXELS_DRAWN, enemyBulletBatch.draw(canvas, enemyBullet.pixels));
   }
 
   void drawPowerups()
   {
     for (int i = 0; i < MAX_POWERUPS; i++)
     {
-      if (!powerups[i].active)
+      if (!powerups[i].active || powerups[i].visibility == VIS_CULLED)
         continue;
 
       int x = powerups[i].pos.x - powerups[i].width / 2;
       int y = powerups[i].pos.y - powerups[i].height / 2;
 
-      const uint16_t *sprite = (powerups[i].type == POWERUP_WEAPON)
-                                   ? powerup_weapon_map
-                                   : powerup_health_map;
-
-      canvas.pushImage(x, y, 16, 16, sprite);
+      const SpriteInfo &s = spriteCache.get(archetypes[powerups[i].type].sprite);
+      drawSprite(powerups[i], x, y, s.width, s.height, s.pixels);
     }
   }
 
@@ -1078,28 +2160,30 @@ public:
   {
     for (int i = 0; i < MAX_EXPLOSIONS; i++)
     {
-      if (!explosions[i].active)
+      if (!explosions[i].active || explosions[i].visibility == VIS_CULLED)
         continue;
 
-      int frame = explosions[i].animFrame;
-      float scale = 1.0 + (frame * 0.3);
-      int size = explosions[i].width * scale;
-
-      // Expanding circles
-      canvas.drawCircle(explosions[i].pos.x, explosions[i].pos.y,
-                        size / 2, TFT_ORANGE);
-      canvas.drawCircle(explosions[i].pos.x, explosions[i].pos.y,
-                        size / 3, TFT_YELLOW);
+      const AnimClip &clip = animClips[CLIP_EXPLOSION];
+      const SpriteInfo &s = spriteCache.get(clip.sheet);
+      const uint16_t *cell = sheetCell(s, clip, explosions[i].animFrame);
+      if (!cell)
+        continue;
+      int x = explosions[i].pos.x - s.width / 2;
+      int y = explosions[i].pos.y - clip.cellHeight / 2;
+      drawSprite(explosions[i], x, y, s.width, clip.cellHeight, cell);
     }
   }
 
   void drawParticles()
   {
+    if (settings.quality == 0)
+      return;
     for (int i = 0; i < MAX_PARTICLES; i++)
     {
-      if (!particles[i].active)
+      if (!particles[i].active || particles[i].visibility == VIS_CULLED)
         continue;
       canvas.fillCircle(particles[i].pos.x, particles[i].pos.y, 2, particles[i].color);
+      overdraw.addCircle(OD_EFFECTS, particles[i].pos.x, particles[i].pos.y, 2);
     }
   }
 
@@ -1110,10 +2194,13 @@ public:
     canvas.setTextSize(2);
 
     // Score
-    canvas.drawString("SCORE: " + String(score), 10, 10);
+    String text = "SCORE: " + String(score);
+    canvas.drawString(text, 10, 10);
+    markText(text.c_str(), 10, 10);
 
     // Lives
     canvas.drawString("LIVES:", 10, 40);
+    markText("LIVES:", 10, 40);
     for (int i = 0; i < lives; i++)
     {
       canvas.fillTriangle(
@@ -1121,65 +2208,1803 @@ public:
           95 + i * 25, 50,
           105 + i * 25, 50,
           TFT_CYAN);
+      overdraw.add(OD_HUD, 95 + i * 25, 40, 11, 11, 60);
     }
 
     // Weapon level
-    canvas.drawString("WPN: " + String(playerWeaponLevel), 10, 70);
+    text = "WPN: " + String(playerWeaponLevel);
+    canvas.drawString(text, 10, 70);
+    markText(text.c_str(), 10, 70);
+  }
+
+  // HUD text at x, y (top-left datum) as its box, for the overdraw map
+  void markText(const char *text, int x, int y)
+  {
+    if (overdraw.active)
+      overdraw.add(OD_HUD, x, y, canvas.textWidth(text), canvas.fontHeight());
   }
 };
 Game game;
 
 // ============================================================================
-// ARDUINO SETUP & LOOP
+// ENVIRONMENTS
 // ============================================================================
 
-void setup()
-{
+// The C API in env_api.h. Each environment is a Game with its own clock
+// and InputSystem fed by inject(), all in one block from allocateEnvs().
 
-  Serial.begin(115200);
-  Serial.println("Space Striker Starting...");
+static_assert(ENV_FRAME_WIDTH * ENV_FRAME_SCALE == SCREEN_WIDTH &&
+                  ENV_FRAME_HEIGHT * ENV_FRAME_SCALE == SCREEN_HEIGHT,
+              "env_api.h frame size does not match the screen");
 
-  // Backlight
-  pinMode(46, OUTPUT);
-  digitalWrite(46, HIGH);
+struct EnvSlot
+{
+  Game game;
+  InputSystem controls;
+  unsigned long clock = 0;
+  int lastScore = 0;
+};
 
-  // Initialize display
-  display.init();
-  display.setRotation(0);
-  display.fillScreen(TFT_BLACK);
+struct GameEnv
+{
+  int count;
+  EnvSlot *slots;
+
+#ifdef ARDUINO
+  // Steps the first half of the batch on the other core during envStep
+  TaskHandle_t worker = nullptr;
+  TaskHandle_t caller = nullptr;
+  const EnvAction *jobActions = nullptr;
+  float *jobRewards = nullptr;
+  uint8_t *jobDones = nullptr;
+  int jobCount = 0;
+
+  static void workerMain(void *arg)
+  {
+    GameEnv *env = (GameEnv *)arg;
+    while (true)
+    {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      envStepRange(env, 0, env->jobCount, env->jobActions, env->jobRewards, env->jobDones);
+      xTaskNotifyGive(env->caller);
+    }
+  }
+#endif
+};
 
-  // Create sprite for double buffering
-  canvas.createSprite(SCREEN_WIDTH, SCREEN_HEIGHT);
-  canvas.setColorDepth(16);
+// Aligned to alignof(EnvSlot): the input rings inside are alignas(64),
+// more than malloc promises. Free with freeEnvs().
+static void *allocateEnvs(size_t bytes)
+{
+#ifdef ARDUINO
+#ifdef BOARD_HAS_PSRAM
+  return heap_caps_aligned_alloc(alignof(EnvSlot), bytes, MALLOC_CAP_SPIRAM);
+#else
+  return heap_caps_aligned_alloc(alignof(EnvSlot), bytes, MALLOC_CAP_8BIT);
+#endif
+#else
+  void *p;
+  return posix_memalign(&p, alignof(EnvSlot), bytes) == 0 ? p : nullptr;
+#endif
+}
 
-  // Initialize systems
-  sound.init();
-  game.init();
+static void freeEnvs(void *p)
+{
+#ifdef ARDUINO
+  heap_caps_free(p);
+#else
+  free(p);
+#endif
+}
 
-  Serial.println("Game initialized!");
+static void startEnv(EnvSlot &slot, uint32_t seed)
+{
+  slot.clock = 0;
+  slot.game.startGame(seed);
+  slot.lastScore = 0;
 }
 
-void loop()
+extern "C" GameEnv *envCreate(int count, uint32_t seed)
 {
-  static unsigned long lastFrame = 0;
-  unsigned long currentTime = millis();
+  if (count <= 0)
+    return nullptr;
+  // Runs need the flight paths and the rest of setup
+  deferred.finish();
+  GameEnv *env = new (std::nothrow) GameEnv;
+  EnvSlot *slots = (EnvSlot *)allocateEnvs(count * sizeof(EnvSlot));
+  if (!env || !slots)
+  {
+    delete env;
+    freeEnvs(slots);
+    return nullptr;
+  }
+  env->count = count;
+  env->slots = slots;
+  for (int i = 0; i < count; i++)
+  {
+    EnvSlot *slot = new (&slots[i]) EnvSlot;
+    slot->game.clock = &slot->clock;
+    slot->game.controls = &slot->controls;
+    slot->game.headless = true;
+  }
+  envReset(env, seed);
 
-  if (currentTime - lastFrame >= FRAME_TIME)
+#ifdef ARDUINO
+  if (count > 1)
   {
-    // Update input
-    input.update();
+    // The loop task runs on core 1, so the helper takes core 0
+    if (xTaskCreatePinnedToCore(GameEnv::workerMain, "envstep", 4096, env, 1, &env->worker, 0) != pdPASS)
+      env->worker = nullptr;
+  }
+#endif
+  return env;
+}
+
+extern "C" void envDestroy(GameEnv *env)
+{
+  if (!env)
+    return;
+#ifdef ARDUINO
+  if (env->worker)
+    vTaskDelete(env->worker);
+#endif
+  for (int i = 0; i < env->count; i++)
+    env->slots[i].~EnvSlot();
+  freeEnvs(env->slots);
+  delete env;
+}
+
+extern "C" int envCount(const GameEnv *env)
+{
+  return env ? env->count : 0;
+}
+
+extern "C" void envReset(GameEnv *env, uint32_t seed)
+{
+  for (int i = 0; i < env->count; i++)
+    startEnv(env->slots[i], seed + i);
+}
+
+extern "C" void envStepRange(GameEnv *env, int first, int n, const EnvAction *actions, float *rewards,
+                             uint8_t *dones)
+{
+  for (int i = first; i < first + n; i++)
+  {
+    EnvSlot &slot = env->slots[i];
+    const EnvAction &a = actions[i];
+    slot.controls.inject({Vec2(a.moveX / 127.0f, a.moveY / 127.0f), (a.buttons & ENV_FIRE) != 0, false});
+    slot.controls.consume();
+    slot.game.update();
+
+    int gained = slot.game.score - slot.lastScore;
+    slot.lastScore = slot.game.score;
+    bool over = slot.game.state != Game::PLAYING;
+    // Each game steps its seed by the batch size, so no two runs share one
+    if (over)
+      startEnv(slot, slot.game.seed + env->count);
+    if (rewards)
+      rewards[i] = gained;
+    if (dones)
+      dones[i] = over;
+  }
+}
+
+extern "C" void envStep(GameEnv *env, const EnvAction *actions, float *rewards, uint8_t *dones)
+{
+#ifdef ARDUINO
+  if (env->worker)
+  {
+    int half = env->count / 2;
+    env->caller = xTaskGetCurrentTaskHandle();
+    env->jobActions = actions;
+    env->jobRewards = rewards;
+    env->jobDones = dones;
+    env->jobCount = half;
+    xTaskNotifyGive(env->worker);
+    envStepRange(env, half, env->count - half, actions, rewards, dones);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+  else
+#endif
+    envStepRange(env, 0, env->count, actions, rewards, dones);
+}
+
+extern "C" void envObserve(const GameEnv *env, EnvObservation *out)
+{
+  for (int e = 0; e < env->count; e++)
+  {
+    Game &g = env->slots[e].game;
+    EnvObservation &o = out[e];
+    o.score = g.score;
+    o.lives = g.lives;
+    o.weaponLevel = g.playerWeaponLevel;
+    o.tick = g.stageTick;
+
+    const Entity &p = g.player;
+    o.objects[0] = {(uint8_t)p.type, 0xFF, (int16_t)p.health, p.pos.x, p.pos.y, p.vel.x, p.vel.y};
+    int n = 1;
+    for (int pool = 0; pool < POOL_COUNT && n < ENV_MAX_OBJECTS; pool++)
+    {
+      int size;
+      const Entity *list = g.pool((EntityPool)pool, size);
+      for (int i = 0; i < size && n < ENV_MAX_OBJECTS; i++)
+        if (list[i].active)
+          o.objects[n++] = {(uint8_t)list[i].type, (uint8_t)pool, (int16_t)list[i].health,
+                            list[i].pos.x, list[i].pos.y, list[i].vel.x, list[i].vel.y};
+    }
+    o.count = n;
+  }
+}
+
+// Fills e's box in frame, clipped to the grid
+static void renderEnvEntity(uint8_t *frame, const Entity &e)
+{
+  Rect r = e.getRect();
+  int x0 = max((int)floorf(r.x / ENV_FRAME_SCALE), 0);
+  int y0 = max((int)floorf(r.y / ENV_FRAME_SCALE), 0);
+  int x1 = min((int)ceilf((r.x + r.w) / ENV_FRAME_SCALE), ENV_FRAME_WIDTH);
+  int y1 = min((int)ceilf((r.y + r.h) / ENV_FRAME_SCALE), ENV_FRAME_HEIGHT);
+  if (x0 >= x1)
+    return;
+  for (int y = y0; y < y1; y++)
+    memset(frame + y * ENV_FRAME_WIDTH + x0, 1 + e.type, x1 - x0);
+}
+
+extern "C" void envRender(const GameEnv *env, uint8_t *frames)
+{
+  static const EntityPool drawn[] = {POOL_POWERUPS, POOL_ENEMIES, POOL_ENEMY_BULLETS, POOL_PLAYER_BULLETS};
+  for (int e = 0; e < env->count; e++)
+  {
+    Game &g = env->slots[e].game;
+    uint8_t *frame = frames + (size_t)e * ENV_FRAME_WIDTH * ENV_FRAME_HEIGHT;
+    memset(frame, 0, ENV_FRAME_WIDTH * ENV_FRAME_HEIGHT);
+    for (EntityPool pool : drawn)
+    {
+      int size;
+      const Entity *list = g.pool(pool, size);
+      for (int i = 0; i < size; i++)
+        if (list[i].active)
+          renderEnvEntity(frame, list[i]);
+    }
+    if (g.player.active)
+      renderEnvEntity(frame, g.player);
+  }
+}
+
+// ============================================================================
+// FRAME OVERRUN WATCHDOG
+// ============================================================================
+
+// Everything needed to reload and re-run a slow frame offline: the state
+// before the frame, the input it consumed, and where its time went.
+struct OverrunDump
+{
+  static const uint32_t MAGIC = 0x4F56524E; // "OVRN"
+
+  uint32_t magic;
+  uint32_t frame;
+  uint32_t frameUs;
+  uint32_t budgetUs;
+  uint32_t spanUs[SPAN_COUNT];
+  uint16_t poolCount[POOL_COUNT];
+  int8_t moveX, moveY;
+  uint8_t fire, touching;
+  GameSnapshot game;
+};
+
+class OverrunWatchdog
+{
+private:
+  static const size_t BYTES_PER_LINE = 32;
+  static const int LINES_PER_FRAME = 4;
+
+  // Pre-frame capture alternates between two slots; on an overrun the
+  // current slot is frozen for output and capture moves to the other one.
+  OverrunDump slots[2];
+  int captureSlot = 0;
+  int dumpSlot = -1;
+  size_t sent = 0;
+  bool headerSent = false;
+  uint32_t frameNumber = 0;
+  uint32_t missed = 0;
+
+public:
+  void beforeFrame()
+  {
+    OverrunDump &d = slots[captureSlot];
+    Vec2 move = input.getMovement();
+    d.moveX = move.x * 127;
+    d.moveY = move.y * 127;
+    d.fire = input.isFirePressed();
+    d.touching = input.getTouching();
+    game.capture(d.game);
+  }
+
+  void afterFrame()
+  {
+    frameNumber++;
+    uint32_t budget = FRAME_TIME * 1000UL;
+    if (profiler.frame() <= budget * OVERRUN_FACTOR)
+      return;
+
+    if (dumpSlot >= 0)
+    {
+      missed++;
+      return;
+    }
+
+    OverrunDump &d = slots[captureSlot];
+    d.magic = OverrunDump::MAGIC;
+    d.frame = frameNumber;
+    d.frameUs = profiler.frame();
+    d.budgetUs = budget;
+    for (int i = 0; i < SPAN_COUNT; i++)
+      d.spanUs[i] = profiler.span((ProfileSpan)i);
+    for (int p = 0; p < POOL_COUNT; p++)
+      d.poolCount[p] = game.activeCount((EntityPool)p);
+
+    dumpSlot = captureSlot;
+    captureSlot ^= 1;
+    sent = 0;
+    headerSent = false;
+  }
+
+  // Streams the frozen dump as hex lines, a few per frame, and only as
+  // much as the UART TX buffer takes without blocking.
+  void pump()
+  {
+    if (dumpSlot < 0)
+      return;
+
+    const OverrunDump &d = slots[dumpSlot];
+    const uint8_t *bytes = (const uint8_t *)&d;
+    size_t total = sizeof(OverrunDump) - sizeof(PackedEntity) * (MAX_POOLED_ENTITIES - d.game.count);
+
+    // The header goes out once, and only whole
+    if (!headerSent)
+    {
+      char header[80];
+      int n = snprintf(header, sizeof(header), "OVR BEGIN frame=%u us=%u size=%u missed=%u\n", d.frame, d.frameUs,
+                       (unsigned)total, missed);
+      if (Serial.availableForWrite() < n)
+        return;
+      Serial.write((const uint8_t *)header, n);
+      headerSent = true;
+    }
+
+    static const char hex[] = "0123456789abcdef";
+    char line[8 + BYTES_PER_LINE * 2 + 2];
+    for (int n = 0; n < LINES_PER_FRAME && sent < total; n++)
+    {
+      if (Serial.availableForWrite() < (int)sizeof(line))
+        return;
+
+      size_t chunk = min((size_t)BYTES_PER_LINE, total - sent);
+      char *p = line;
+      *p++ = 'O';
+      *p++ = 'V';
+      *p++ = 'R';
+      *p++ = ' ';
+      for (size_t i = 0; i < chunk; i++)
+      {
+        *p++ = hex[bytes[sent + i] >> 4];
+        *p++ = hex[bytes[sent + i] & 0xF];
+      }
+      *p++ = '\n';
+      Serial.write((const uint8_t *)line, p - line);
+      sent += chunk;
+    }
+
+    if (sent >= total)
+    {
+      if (Serial.availableForWrite() < 8)
+        return;
+      Serial.println("OVR END");
+      dumpSlot = -1;
+      missed = 0;
+    }
+  }
+};
+
+OverrunWatchdog watchdog;
+
+// ============================================================================
+// REWIND
+// ============================================================================
+
+// The last REWIND_TICKS of the current run: a snapshot every
+// REWIND_INTERVAL ticks plus the input of every tick, so the game can be
+// put back to any tick in that window by restoring the snapshot before it
+// and re-simulating the rest.
+class RewindHistory
+{
+private:
+  static const int SNAPSHOTS = REWIND_TICKS / REWIND_INTERVAL + 1;
+  static const int INPUTS = REWIND_TICKS + REWIND_INTERVAL;
+
+  RewindBuffer<SNAPSHOTS> buffer;
+  InputSystem::InputSample inputs[INPUTS]; // indexed by tick, exactly as consumed
+  RewindState state;
+  uint32_t captures = 0;
+  uint32_t captureUs = 0;
+  uint32_t maxCaptureUs = 0;
+
+  void capture()
+  {
+    memset(&state, 0, sizeof(state));
+    game.captureExact(state);
+  }
+
+public:
+  uint32_t resimUs = 0;
+
+  bool begin() { return buffer.begin(sizeof(RewindState), REWIND_BYTES); }
+
+  // Call after every game.update() with the input that update consumed
+  void afterUpdate(bool wasPlaying)
+  {
+    if (!buffer.active() || !wasPlaying)
+      return;
+    uint32_t tick = game.stageTick - 1;
+    if (tick == 0)
+    {
+      buffer.clear();
+      captures = captureUs = maxCaptureUs = 0;
+    }
+
+    inputs[tick % INPUTS] = {input.getMovement(), input.isFirePressed(), input.getTouching()};
+
+    if (game.stageTick % REWIND_INTERVAL == 0)
+    {
+      uint32_t t0 = micros();
+      capture();
+      buffer.push(game.stageTick, gameTime, &state);
+      uint32_t us = micros() - t0;
+      captures++;
+      captureUs += us;
+      maxCaptureUs = max(maxCaptureUs, us);
+    }
+
+    if (game.state != Game::PLAYING)
+      print();
+  }
+
+  const InputSystem::InputSample &inputAt(uint32_t tick) const { return inputs[tick % INPUTS]; }
+
+  // Puts the run back to how it was after tick ticks and drops the
+  // history past it. False when tick is outside the window.
+  bool rewindTo(uint32_t tick)
+  {
+    if (tick >= game.stageTick || game.stageTick - tick > REWIND_TICKS || tick < buffer.oldestTick())
+      return false;
+    uint32_t from, time;
+    if (!buffer.rewind(tick, &state, from, time))
+      return false;
+
+    uint32_t t0 = micros();
+    gameTime = time;
+    game.restoreExact(state);
+    for (uint32_t k = from; k < tick; k++)
+    {
+      input.inject(inputAt(k));
+      input.consume();
+      game.update();
+    }
+    resimUs = micros() - t0;
+    return true;
+  }
+
+  uint32_t restoreUs() const { return buffer.lastRestoreUs; }
+
+  void print()
+  {
+    uint32_t span = buffer.newestTick() - buffer.oldestTick();
+    uint32_t used = buffer.usedBytes();
+    float seconds = (float)span / GAME_FPS;
+    Serial.printf("REWIND %d snapshots over %.1fs, %u B deltas + %u B inputs, %.0f B/s\n",
+                  buffer.snapshots(), seconds, used, (unsigned)sizeof(inputs),
+                  seconds > 0 ? used / seconds + sizeof(ReplayRun) * GAME_FPS : 0.0f);
+    Serial.printf("REWIND capture avg=%u max=%u us, last restore=%u us\n",
+                  captures ? captureUs / captures : 0, maxCaptureUs, buffer.lastRestoreUs);
+  }
+};
+
+#if REWIND_ENABLED
+RewindHistory history;
+#endif
+TelemetryStream telemetry;
+
+void submitTelemetry(uint32_t frame)
+{
+  TelemetryRecord rec;
+  rec.frame = frame;
+  rec.frameUs = profiler.frame();
+  for (int i = 0; i < SPAN_COUNT; i++)
+    rec.spanUs[i] = min(profiler.span((ProfileSpan)i), (uint32_t)0xFFFF);
+  for (int p = 0; p < POOL_COUNT; p++)
+    rec.poolCount[p] = game.activeCount((EntityPool)p);
+  rec.collisionTests = min(profiler.counter(COUNT_COLLISION_TESTS), (uint32_t)0xFFFF);
+  rec.pixelsDrawn = profiler.counter(COUNT_PIXELS_DRAWN);
+  rec.bytesFlushed = profiler.counter(COUNT_BYTES_FLUSHED);
+  rec.heapFree = ESP.getFreeHeap();
+  rec.culled = min(profiler.counter(COUNT_CULLED), (uint32_t)0xFFFF);
+  rec.fastDraws = min(profiler.counter(COUNT_FAST_DRAWS), (uint32_t)0xFFFF);
+  telemetry.submit(rec);
+}
+
+// ============================================================================
+// CONSOLE
+// ============================================================================
+
+// Serial commands for tuning on the device without reflashing; type help
+// for the list. Everything acts on the game on screen.
+SerialConsole console;
+
+static const char *const poolNames[POOL_COUNT] = {"enemies", "pbullets", "ebullets", "powerups", "explosions",
+                                                  "particles"};
+
+// Index of name in names, or -1 (and a reply saying so)
+static int findName(const char *name, const char *const *names, int count, const char *what)
+{
+  for (int i = 0; i < count; i++)
+    if (strcmp(name, names[i]) == 0)
+      return i;
+  console.printf("no %s '%s'\n", what, name);
+  return -1;
+}
+
+// on or off from argv[1], or the opposite of current without one
+static bool parseSwitch(int argc, char **argv, bool current, bool &on)
+{
+  if (argc < 2)
+    on = !current;
+  else if (strcmp(argv[1], "on") == 0)
+    on = true;
+  else if (strcmp(argv[1], "off") == 0)
+    on = false;
+  else
+  {
+    console.printf("expected on or off\n");
+    return false;
+  }
+  return true;
+}
+
+static void cmdProf(int, char **)
+{
+  console.printf("frame %u us (budget %u)\n", profiler.frame(), FRAME_TIME * 1000);
+  for (int s = 0; s < SPAN_COUNT; s++)
+    console.printf("  %-10s %6u us%s\n", FrameProfiler::spanName((ProfileSpan)s), profiler.span((ProfileSpan)s),
+                   profiler.disabled & (1u << s) ? " (off)" : "");
+  for (int c = 0; c < COUNTER_COUNT; c++)
+    console.printf("  %-10s %6u\n", FrameProfiler::counterName((ProfileCounter)c),
+                   profiler.counter((ProfileCounter)c));
+  console.printf("console %u us, max %u, %u B dropped\n", console.lastUs, console.maxUs, console.dropped);
+}
+
+static void cmdSpan(int argc, char **argv)
+{
+  if (argc < 2)
+  {
+    console.printf("span <name> [on|off]\n");
+    return;
+  }
+  static const char *names[SPAN_COUNT];
+  for (int s = 0; s < SPAN_COUNT; s++)
+    names[s] = FrameProfiler::spanName((ProfileSpan)s);
+  int s = findName(argv[1], names, SPAN_COUNT, "span");
+  if (s < 0)
+    return;
+  bool on;
+  if (!parseSwitch(argc - 1, argv + 1, !(profiler.disabled & (1u << s)), on))
+    return;
+  profiler.disabled = on ? profiler.disabled & ~(1u << s) : profiler.disabled | (1u << s);
+  console.printf("span %s %s\n", names[s], on ? "on" : "off");
+}
+
+static void cmdBlit(int argc, char **argv)
+{
+  if (argc > 1 && strcmp(argv[1], "fast") != 0 && strcmp(argv[1], "clip") != 0)
+  {
+    console.printf("blit [fast|clip]\n");
+    return;
+  }
+  settings.fastBlits = argc > 1 ? strcmp(argv[1], "fast") == 0 : !settings.fastBlits;
+  console.printf("blit %s\n", settings.fastBlits ? "fast" : "clip");
+}
+
+static void cmdOverlay(int argc, char **argv)
+{
+  if (!parseSwitch(argc, argv, settings.overlay, settings.overlay))
+    return;
+  console.printf("overlay %s\n", settings.overlay ? "on" : "off");
+}
+
+static void cmdQuality(int argc, char **argv)
+{
+  if (argc > 1)
+  {
+    int q = atoi(argv[1]);
+    if (q < 0 || q > 2)
+    {
+      console.printf("quality 0..2\n");
+      return;
+    }
+    settings.quality = q;
+  }
+  console.printf("quality %u\n", settings.quality);
+}
+
+static void cmdPool(int argc, char **argv)
+{
+  if (argc < 2)
+  {
+    for (int p = 0; p < POOL_COUNT; p++)
+      console.printf("  %-10s %3d/%3u of %3u, high %u, overflows %u\n", poolNames[p],
+                     game.activeCount((EntityPool)p), game.poolLimit[p] ? game.poolLimit[p] : poolCapacity[p],
+                     poolCapacity[p], game.poolStats[p].highWater, game.poolStats[p].overflows);
+    return;
+  }
+  int p = findName(argv[1], poolNames, POOL_COUNT, "pool");
+  if (p < 0)
+    return;
+  if (argc > 2)
+  {
+    int limit = atoi(argv[2]);
+    if (limit < 1 || limit > poolCapacity[p])
+    {
+      console.printf("%s takes 1..%u\n", poolNames[p], poolCapacity[p]);
+      return;
+    }
+    // Entities already past the new limit live on until they die
+    game.poolLimit[p] = limit == poolCapacity[p] ? 0 : limit;
+    if (game.poolLimit[p])
+      game.tainted = true;
+  }
+  console.printf("%s limit %u of %u\n", poolNames[p], game.poolLimit[p] ? game.poolLimit[p] : poolCapacity[p],
+                 poolCapacity[p]);
+}
+
+// Fills the screen with enemies and their bullets to see the worst case
+static void cmdStress(int argc, char **argv)
+{
+  const int most = min(MAX_ENEMIES, MAX_ENEMY_BULLETS);
+  int n = argc > 1 ? atoi(argv[1]) : most;
+  if (n < 1 || n > most)
+  {
+    console.printf("stress takes 1..%d\n", most);
+    return;
+  }
+  if (game.state != Game::PLAYING)
+  {
+    console.printf("start a game first\n");
+    return;
+  }
+  game.tainted = true;
+  int before = game.activeCount(POOL_ENEMIES) + game.activeCount(POOL_ENEMY_BULLETS);
+  for (int i = 0; i < n; i++)
+  {
+    float x = 20 + (i * 37) % (SCREEN_WIDTH - 40);
+    float y = 20 + (i * 53) % (SCREEN_HEIGHT / 2);
+    game.spawnEnemy(i % 3 ? ENEMY_BASIC : ENEMY_TANK, Vec2(x, y), Vec2(0, archetypes[ENEMY_BASIC].speed));
+    game.spawnEnemyBullet(Vec2(x, y + 10), Vec2((i % 5 - 2) * 0.5f, archetypes[BULLET_ENEMY].speed));
+  }
+  int after = game.activeCount(POOL_ENEMIES) + game.activeCount(POOL_ENEMY_BULLETS);
+  console.printf("stress: %d spawned\n", after - before);
+}
+
+static void cmdOverdraw(int argc, char **argv)
+{
+  if (argc > 1 && strcmp(argv[1], "off") == 0)
+  {
+    overdraw.end();
+    console.printf("overdraw off\n");
+  }
+  else if (argc > 1 && strcmp(argv[1], "on") == 0)
+    console.printf(overdraw.begin(SCREEN_WIDTH, SCREEN_HEIGHT) ? "overdraw counting\n" : "overdraw: no memory\n");
+  else if (!overdraw.active)
+    console.printf("overdraw is off, 'overdraw on' starts it\n");
+  else
+  {
+    overdraw.print(console);
+    console.printf("OVERDRAW average %.2f writes/pixel over %u frames\n", overdraw.averageOverdraw(),
+                   overdraw.frames);
+  }
+}
+
+#if REWIND_ENABLED
+static void cmdRewind(int argc, char **argv)
+{
+  int ticks = argc > 1 ? atoi(argv[1]) : GAME_FPS;
+  if (game.state != Game::PLAYING || ticks <= 0 || (uint32_t)ticks > game.stageTick ||
+      !history.rewindTo(game.stageTick - ticks))
+  {
+    console.printf("cannot rewind %d ticks\n", ticks);
+    return;
+  }
+  console.printf("back to tick %u: restore %u us, resim %u us\n", game.stageTick, history.restoreUs(),
+                 history.resimUs);
+}
+#endif
+
+static const ConsoleCommand consoleCommands[] = {
+    {"prof", "last frame's spans and counters", cmdProf},
+    {"span", "<name> [on|off]  time a profiler span or not", cmdSpan},
+    {"blit", "[fast|clip]  unclipped blits on screen", cmdBlit},
+    {"overlay", "[on|off]  frame timings on screen", cmdOverlay},
+    {"quality", "[0..2]  background and particles", cmdQuality},
+    {"pool", "[<name> <limit>]  pool use, or cap one", cmdPool},
+    {"stress", "[n]  spawn n enemies and bullets", cmdStress},
+    {"overdraw", "[on|off]  pixel writes per block", cmdOverdraw},
+#if REWIND_ENABLED
+    {"rewind", "[ticks]  step the game back", cmdRewind},
+#endif
+};
+
+// ============================================================================
+// REPLAY RECORDING & BENCHMARK
+// ============================================================================
+
+class ReplayRecorder
+{
+private:
+  static const int MAX_RUNS = 512;
+  ReplayRun runs[MAX_RUNS];
+  int runCount = 0;
+  bool recording = false;
+  bool overflow = false;
+  uint32_t seed;
+  uint32_t startTime;
+
+public:
+  // Call after every game.update() with the input that update consumed
+  void afterUpdate(bool wasPlaying)
+  {
+    bool playing = game.state == Game::PLAYING;
+    if (playing && !wasPlaying)
+    {
+      // startGame() ran inside this update, recording starts with the next
+      recording = true;
+      overflow = false;
+      runCount = 0;
+      seed = game.seed;
+      startTime = gameTime;
+      return;
+    }
+    if (!recording)
+      return;
+    if (!playing)
+    {
+      recording = false;
+      print();
+      return;
+    }
+
+    // Record exactly what this update read
+    Vec2 move = input.getMovement();
+    ReplayRun r = {1, (int8_t)round(move.x * 127), (int8_t)round(move.y * 127),
+                   (uint8_t)((input.isFirePressed() ? REPLAY_FIRE : 0) |
+                             (input.getTouching() ? REPLAY_TOUCH : 0))};
+    if (runCount > 0)
+    {
+      ReplayRun &last = runs[runCount - 1];
+      if (last.moveX == r.moveX && last.moveY == r.moveY && last.buttons == r.buttons &&
+          last.frames < 0xFFFF)
+      {
+        last.frames++;
+        return;
+      }
+    }
+    if (runCount < MAX_RUNS)
+      runs[runCount++] = r;
+    else
+      overflow = true;
+  }
+
+private:
+  void print()
+  {
+    Serial.printf("// replay seed=0x%08X start=%u runs=%d%s\n", seed, startTime, runCount,
+                  overflow ? " (truncated)" : "");
+    Serial.printf("const ReplayRun replay_rec_%08x_runs[] PROGMEM = {\n", seed);
+    for (int i = 0; i < runCount; i++)
+      Serial.printf("    {%u, %d, %d, %u},\n", runs[i].frames, runs[i].moveX, runs[i].moveY,
+                    runs[i].buttons);
+    Serial.println("};");
+    Serial.printf("    REPLAY_ENTRY(rec_%08x, 0x%08X, %u),\n", seed, seed, startTime);
+  }
+};
+
+#if RECORD_REPLAYS
+ReplayRecorder recorder;
+#endif
+
+#ifdef BENCHMARK
+#include <algorithm>
+#include "replay_baselines.h"
+
+// Plays every replay headless through Game::update and Game::render into
+// the canvas (never pushed to the panel) and compares the frame time
+// distribution with replay_baselines.h.
+class ReplayBenchmark
+{
+private:
+  static const int MAX_FRAMES = 2048;
+  uint32_t updateUs[MAX_FRAMES];
+  uint32_t drawUs[MAX_FRAMES];
+  uint32_t totalUs[MAX_FRAMES];
+
+  static uint32_t percentile(uint32_t *sorted, int n, int pct)
+  {
+    return n > 0 ? sorted[(n - 1) * pct / 100] : 0;
+  }
+
+  static const ReplayBaseline *findBaseline(const char *name)
+  {
+    for (size_t i = 0; i < sizeof(replayBaselines) / sizeof(ReplayBaseline); i++)
+      if (strcmp(replayBaselines[i].replay, name) == 0)
+        return &replayBaselines[i];
+    return nullptr;
+  }
+
+  int play(const Replay &r)
+  {
+    char label[32];
+    snprintf(label, sizeof(label), "replay/%s", r.name);
+    poolStore.label = label;
+
+    gameTime = r.startTime;
+    game.startGame(r.seed);
+
+    int frames = 0;
+    for (int run = 0; run < r.runCount && game.state == Game::PLAYING; run++)
+    {
+      const ReplayRun &rr = r.runs[run];
+      InputSystem::InputSample sample = {Vec2(rr.moveX / 127.0f, rr.moveY / 127.0f),
+                                         (rr.buttons & REPLAY_FIRE) != 0,
+                                         (rr.buttons & REPLAY_TOUCH) != 0};
+      for (int f = 0; f < rr.frames && frames < MAX_FRAMES; f++)
+      {
+        input.inject(sample);
+        input.consume();
+
+        uint32_t t0 = micros();
+        game.update();
+        uint32_t t1 = micros();
+        game.render(false);
+        uint32_t t2 = micros();
+
+        updateUs[frames] = t1 - t0;
+        drawUs[frames] = t2 - t1;
+        totalUs[frames] = t2 - t0;
+        frames++;
+        if (game.state != Game::PLAYING)
+          break;
+      }
+    }
+
+    // A run that dies reports its pools from Game::update already
+    if (game.state == Game::PLAYING)
+      poolStore.recordRun(game.poolStats, game.tainted);
+    poolStore.label = "run";
+    return frames;
+  }
+
+public:
+  // Replays the last run() had nothing to compare against
+  int unbaselined = 0;
+
+  // Returns the number of replays that regressed past the tolerance;
+  // replays without a baseline are counted in unbaselined, not passed
+  int run()
+  {
+    // Replays are not real sessions, keep them out of the lifetime stats
+    poolStore.persist = false;
+    int regressions = 0;
+    unbaselined = 0;
+    for (size_t i = 0; i < REPLAY_COUNT; i++)
+    {
+      const Replay &r = replays[i];
+      int n = play(r);
+
+      std::sort(updateUs, updateUs + n);
+      std::sort(drawUs, drawUs + n);
+      std::sort(totalUs, totalUs + n);
+      uint32_t p50 = percentile(totalUs, n, 50);
+      uint32_t p99 = percentile(totalUs, n, 99);
+
+      Serial.printf("BENCH %-8s frames=%4d update p50=%u p99=%u  draw p50=%u p99=%u  "
+                    "total p50=%u p99=%u max=%u us\n",
+                    r.name, n, percentile(updateUs, n, 50), percentile(updateUs, n, 99),
+                    percentile(drawUs, n, 50), percentile(drawUs, n, 99), p50, p99,
+                    n > 0 ? totalUs[n - 1] : 0);
+
+      const ReplayBaseline *base = findBaseline(r.name);
+      if (!base || base->p50Us == 0)
+      {
+        Serial.printf("  NO BASELINE, not compared; record: {\"%s\", %u, %u},\n", r.name, p50, p99);
+        unbaselined++;
+        continue;
+      }
+
+      bool slow = p50 * 100 > base->p50Us * (100 + BENCH_TOLERANCE_PCT) ||
+                  p99 * 100 > base->p99Us * (100 + BENCH_TOLERANCE_PCT);
+      Serial.printf("  baseline p50=%u p99=%u -> %s (p50 %+d%%, p99 %+d%%)\n",
+                    base->p50Us, base->p99Us, slow ? "REGRESSION" : "ok",
+                    (int)((int64_t)p50 * 100 / base->p50Us) - 100,
+                    (int)((int64_t)p99 * 100 / base->p99Us) - 100);
+      if (slow)
+        regressions++;
+    }
+    poolStore.persist = true;
+    return regressions;
+  }
+
+  // Replays the first replay with the sprite cache at several sizes
+  void runCacheSweep()
+  {
+    static const uint32_t sizesKb[] = {16, 32, 64, 128, 256};
+    for (size_t i = 0; i < sizeof(sizesKb) / sizeof(sizesKb[0]); i++)
+    {
+      if (!spriteCache.begin(assets, sizesKb[i] * 1024))
+      {
+        Serial.printf("CACHE %ukB: allocation failed\n", sizesKb[i]);
+        continue;
+      }
+      pinHotSprites();
+      int n = play(replays[0]);
+      std::sort(drawUs, drawUs + n);
+      Serial.printf("CACHE %3ukB draw p50=%u p99=%u us  hits=%u misses=%u evictions=%u "
+                    "failures=%u used=%u\n",
+                    sizesKb[i], percentile(drawUs, n, 50), percentile(drawUs, n, 99),
+                    spriteCache.hits, spriteCache.misses, spriteCache.evictions,
+                    spriteCache.failures, spriteCache.used());
+    }
+    spriteCache.begin(assets);
+    pinHotSprites();
+  }
+};
+
+ReplayBenchmark benchmark;
+
+// Blit throughput of every sprite from the mapped bundle and from the
+// arrays compiled into the image, in pixels per microsecond
+void benchmarkBlits()
+{
+  const int REPS = 2000;
+  for (int i = 0; i < SPRITE_COUNT; i++)
+  {
+    const SpriteInfo *sources[2] = {&AssetStore::builtin((SpriteId)i), &assets.sprite((SpriteId)i)};
+    float rate[2] = {0, 0};
+    for (int k = 0; k < 2; k++)
+    {
+      // Compressed entries have no directly blittable pixels
+      const SpriteInfo &s = *sources[k];
+      if (!s.pixels || (k == 1 && !assets.mapped()))
+        continue;
+      uint32_t t0 = micros();
+      for (int r = 0; r < REPS; r++)
+        canvas.pushImage((r * 7) % (SCREEN_WIDTH - s.width), (r * 13) % (SCREEN_HEIGHT - s.height),
+                         s.width, s.height, s.pixels);
+      uint32_t us = micros() - t0;
+      rate[k] = (float)REPS * s.width * s.height / (us ? us : 1);
+    }
+    Serial.printf("BLIT sprite=%d %dx%d image=%.1f mapped=%.1f px/us\n", i,
+                  sources[0]->width, sources[0]->height, rate[0], rate[1]);
+  }
+
+  // A rotated variant is an ordinary image of the same size
+  for (int i = 0; i < SPRITE_COUNT; i++)
+  {
+    const SpriteInfo &s = AssetStore::builtin((SpriteId)i);
+    if (!rotations.variant((SpriteId)i, 0))
+      continue;
+    uint32_t t0 = micros();
+    for (int r = 0; r < REPS; r++)
+      canvas.pushImage((r * 7) % (SCREEN_WIDTH - s.width), (r * 13) % (SCREEN_HEIGHT - s.height),
+                       s.width, s.height, rotations.variant((SpriteId)i, r));
+    uint32_t us = micros() - t0;
+    Serial.printf("BLIT sprite=%d %dx%d rotated=%.1f px/us\n", i, s.width, s.height,
+                  (float)REPS * s.width * s.height / (us ? us : 1));
+  }
+
+  // Direct buffer blits, one line per variant, on the tank sprite
+  ColorLut tint, darken;
+  tint.toward(TFT_RED, 96);
+  darken.scale(128);
+  struct Variant
+  {
+    const char *name;
+    uint8_t flags;
+    const ColorLut *lut;
+  };
+  const Variant variants[] = {
+      {"copy", 0, nullptr},
+      {"mirror-x", BLIT_MIRROR_X, nullptr},
+      {"mirror-xy", BLIT_MIRROR_X | BLIT_MIRROR_Y, nullptr},
+      {"flash", 0, &hitFlash},
+      {"tint", 0, &tint},
+      {"darken", 0, &darken},
+      {"flash+mirror", BLIT_MIRROR_X, &hitFlash},
+  };
+  const SpriteInfo &s = AssetStore::builtin(SPRITE_ENEMY_TANK);
+  for (const Variant &v : variants)
+  {
+    uint32_t t0 = micros();
+    uint32_t pixels = 0;
+    for (int r = 0; r < REPS; r++)
+      pixels += blitImage(canvas, (r * 7) % (SCREEN_WIDTH - s.width), (r * 13) % (SCREEN_HEIGHT - s.height),
+                          s.width, s.height, s.pixels, v.flags, v.lut);
+    uint32_t us = micros() - t0;
+    Serial.printf("BLIT %-12s %dx%d %.1f px/us\n", v.name, s.width, s.height, (float)pixels / (us ? us : 1));
+  }
+}
+
+// One frame's worth of bullets, batched from spans against one
+// pushImage() per bullet, all on screen
+void benchmarkBullets()
+{
+  const int N = 2000;
+  const int FRAMES = 20;
+  static BulletBatch<N> batch;
+  const SpriteInfo &s = spriteCache.get(SPRITE_BULLET_ENEMY);
+  batch.build(s);
+
+  uint32_t batchedUs = 0, perCallUs = 0;
+  for (int f = 0; f < FRAMES; f++)
+  {
+    uint32_t t0 = micros();
+    batch.clear();
+    for (int i = 0; i < N; i++)
+      batch.add((i * 37 + f) % (SCREEN_WIDTH - s.width), (i * 53 + f * 3) % (SCREEN_HEIGHT - s.height));
+    batch.draw(canvas, s.pixels);
+    batchedUs += micros() - t0;
+
+    t0 = micros();
+    for (int i = 0; i < N; i++)
+      canvas.pushImage((i * 37 + f) % (SCREEN_WIDTH - s.width), (i * 53 + f * 3) % (SCREEN_HEIGHT - s.height),
+                       s.width, s.height, s.pixels);
+    perCallUs += micros() - t0;
+  }
+  Serial.printf("BULLETS n=%d batched=%u pushImage=%u us/frame (budget %d us)\n", N,
+                batchedUs / FRAMES, perCallUs / FRAMES, FRAME_TIME * 1000);
+}
+
+// Narrow-phase kernel throughput, one query box against 16 candidates.
+// Both versions must agree on every mask.
+void benchmarkAabb()
+{
+  const int QUERIES = 4096;
+  static AabbSoA<16> boxes;
+  static float q[QUERIES][4];
+  randomSeed(1234);
+  for (int i = 0; i < 16; i++)
+  {
+    float x = random(0, SCREEN_WIDTH), y = random(0, SCREEN_HEIGHT);
+    boxes.set(i, x, y, x + random(8, 40), y + random(8, 40));
+  }
+  for (int k = 0; k < QUERIES; k++)
+  {
+    q[k][0] = random(0, SCREEN_WIDTH);
+    q[k][1] = random(0, SCREEN_HEIGHT);
+    q[k][2] = q[k][0] + 4;
+    q[k][3] = q[k][1] + 8;
+  }
+
+  uint32_t sink = 0, mismatches = 0;
+  uint32_t t0 = micros();
+  for (int k = 0; k < QUERIES; k++)
+    sink += overlapScalar(boxes, q[k][0], q[k][1], q[k][2], q[k][3]);
+  uint32_t scalarUs = micros() - t0;
+  t0 = micros();
+  for (int k = 0; k < QUERIES; k++)
+    sink += overlapVector(boxes, q[k][0], q[k][1], q[k][2], q[k][3]);
+  uint32_t vectorUs = micros() - t0;
+  for (int k = 0; k < QUERIES; k++)
+    if (overlapScalar(boxes, q[k][0], q[k][1], q[k][2], q[k][3]) !=
+        overlapVector(boxes, q[k][0], q[k][1], q[k][2], q[k][3]))
+      mismatches++;
+
+  float tests = QUERIES * 16.0f;
+  Serial.printf("AABB scalar=%.1f vector=%.1f tests/us mismatches=%u (%u)\n",
+                tests / (scalarUs ? scalarUs : 1), tests / (vectorUs ? vectorUs : 1), mismatches, sink & 1);
+}
+
+// Cost of one animation tick over many entities: the batched pass against
+// the per-entity millis() check it replaced
+void benchmarkAnimation()
+{
+  const int N = 1000;
+  const int TICKS = 300;
+  static Entity crowd[N];
+  static unsigned long lastAnim[N];
+  for (int i = 0; i < N; i++)
+  {
+    crowd[i].init(EXPLOSION, Vec2(0, 0), Vec2(0, 0), 24, 24, 1, TFT_ORANGE);
+    crowd[i].play(CLIP_EXPLOSION);
+    lastAnim[i] = 0;
+  }
+
+  uint32_t batched = 0;
+  for (int t = 0; t < TICKS; t++)
+  {
+    uint32_t t0 = micros();
+    animateEntities(crowd, N);
+    batched += micros() - t0;
+    for (int i = 0; i < N; i++)
+      if (!crowd[i].animating())
+        crowd[i].play(CLIP_EXPLOSION);
+  }
+
+  uint32_t legacy = 0;
+  for (int t = 0; t < TICKS; t++)
+  {
+    uint32_t t0 = micros();
+    for (int i = 0; i < N; i++)
+    {
+      if (!crowd[i].active)
+        continue;
+      if (millis() - lastAnim[i] > 50)
+      {
+        crowd[i].animFrame = (crowd[i].animFrame + 1) % 6;
+        lastAnim[i] = millis();
+      }
+    }
+    legacy += micros() - t0;
+  }
+
+  Serial.printf("ANIM n=%d batched=%.1f legacy=%.1f us/tick\n", N,
+                (float)batched / TICKS, (float)legacy / TICKS);
+}
+
+// Placing formation members: sampling the shared baked table against
+// evaluating the spline for every ship
+void benchmarkFormations()
+{
+  const int FORMATIONS = 50;
+  const int MEMBERS = 10;
+  const int TICKS = 300;
+  const PathDef &def = pathDefs[PATH_WEAVE];
+  const PathTable &table = paths[PATH_WEAVE];
+  float segments = (def.count - 1) / table.length;
+
+  static PathPoint out[FORMATIONS * MEMBERS];
+  float distance[FORMATIONS];
+
+  for (int f = 0; f < FORMATIONS; f++)
+    distance[f] = f * 10.0f;
+  uint32_t baked = 0;
+  for (int t = 0; t < TICKS; t++)
+  {
+    uint32_t t0 = micros();
+    for (int f = 0; f < FORMATIONS; f++)
+    {
+      distance[f] += 3.0f;
+      for (int m = 0; m < MEMBERS; m++)
+        out[f * MEMBERS + m] = table.at(distance[f] - m * 20.0f);
+    }
+    baked += micros() - t0;
+  }
+  float sink = out[0].x;
+
+  for (int f = 0; f < FORMATIONS; f++)
+    distance[f] = f * 10.0f;
+  uint32_t spline = 0;
+  for (int t = 0; t < TICKS; t++)
+  {
+    uint32_t t0 = micros();
+    for (int f = 0; f < FORMATIONS; f++)
+    {
+      distance[f] += 3.0f;
+      for (int m = 0; m < MEMBERS; m++)
+      {
+        float u = constrain((distance[f] - m * 20.0f) * segments, 0.0f, def.count - 1.0f);
+        out[f * MEMBERS + m] = catmullRom(def.points, def.count, u);
+      }
+    }
+    spline += micros() - t0;
+  }
+  sink += out[0].x;
+
+  Serial.printf("FORMATION %dx%d baked=%.1f spline=%.1f us/tick (%d)\n", FORMATIONS, MEMBERS,
+                (float)baked / TICKS, (float)spline / TICKS, (int)sink & 1);
+}
+
+// Hash of every cue in segments 0..count-1 as play would see them, with
+// the generator stepped by budgetUs once per tick
+static uint32_t stageChecksum(uint32_t seed, uint32_t count, uint32_t budgetUs, uint32_t &sumUs,
+                              uint32_t &maxUs, uint32_t &misses)
+{
+  static StageGenerator gen;
+  gen.begin(seed, SCREEN_WIDTH, PATH_COUNT, SHAPE_COUNT);
+  uint32_t hash = 0;
+  sumUs = 0;
+  for (uint32_t tick = 0; tick < count * SEGMENT_TICKS; tick++)
+  {
+    if (tick % SEGMENT_TICKS == 0)
+    {
+      const StageSegment &s = gen.segment(tick / SEGMENT_TICKS);
+      for (int i = 0; i < s.cueCount; i++)
+      {
+        const StageCue &c = s.cues[i];
+        hash = mix32(hash ^ (c.tick | c.kind << 16 | c.variant << 24));
+        hash = mix32(hash ^ (c.x | c.path << 16 | c.shape << 24));
+      }
+    }
+    gen.step(budgetUs);
+    sumUs += gen.lastUs;
+  }
+  maxUs = gen.maxUs;
+  misses = gen.misses;
+  return hash;
+}
+
+// Generation cost per tick over a long run, and that the output depends
+// only on the seed: sliced, one unit per tick and a re-run all agree
+void benchmarkStageGen()
+{
+  const uint32_t SEGMENTS = 100;
+  uint32_t sumUs, maxUs, misses, ignore;
+  uint32_t sliced = stageChecksum(1234, SEGMENTS, GEN_SLICE_US, sumUs, maxUs, misses);
+  uint32_t single = stageChecksum(1234, SEGMENTS, 0, ignore, ignore, ignore);
+  uint32_t again = stageChecksum(1234, SEGMENTS, GEN_SLICE_US, ignore, ignore, ignore);
+  uint32_t other = stageChecksum(4321, SEGMENTS, GEN_SLICE_US, ignore, ignore, ignore);
+
+  // Background rows: same seed, same rows, whatever order they are read in
+  struct HeaderOnly : StageSource
+  {
+    bool read(uint32_t offset, void *dst, size_t len) override
+    {
+      StageHeader h = {STAGE_MAGIC, STAGE_VERSION, 1, 10, 64, 6, 0};
+      uint8_t bytes[sizeof(h) + 12] = {};
+      memcpy(bytes, &h, sizeof(h));
+      if (offset + len > sizeof(bytes))
+        return false;
+      memcpy(dst, bytes + offset, len);
+      return true;
+    }
+  } tiles;
+  ProceduralStageSource map(tiles, 1234);
+  uint32_t mapOffset = sizeof(StageHeader) + 12;
+  const int ROWS = 256;
+  static uint8_t ascending[ROWS][10];
+  for (int r = 0; r < ROWS; r++)
+    map.read(mapOffset + r * 10, ascending[r], 10);
+  uint8_t row[10];
+  bool mapStable = true;
+  for (int r = ROWS - 1; r >= 0; r--)
+  {
+    map.read(mapOffset + r * 10, row, 10);
+    mapStable &= memcmp(row, ascending[r], 10) == 0;
+  }
+
+  uint32_t ticks = SEGMENTS * SEGMENT_TICKS;
+  Serial.printf("STAGEGEN %u segments %.2f us/tick max=%u us misses=%u\n", SEGMENTS,
+                (float)sumUs / ticks, maxUs, misses);
+  Serial.printf("STAGEGEN deterministic=%s seeds differ=%s map=%s\n",
+                sliced == single && sliced == again ? "yes" : "NO", sliced != other ? "yes" : "NO",
+                mapStable ? "yes" : "NO");
+}
+
+// Waking placed entities as the camera sweeps worlds of growing size at
+// the same density: sector buckets against scanning every placement
+void benchmarkWorld()
+{
+  const int TICKS = 1000;
+  const uint32_t sizes[] = {1000, 10000};
+  static World bench;
+
+  struct Flat
+  {
+    int32_t x, y;
+    bool awake;
+  };
+
+  for (uint32_t n : sizes)
+  {
+    // Four placements per sector, so a bigger world is a longer one
+    uint32_t columns = (SCREEN_WIDTH + SECTOR_SIZE - 1) / SECTOR_SIZE;
+    uint32_t height = n / (4 * columns) * SECTOR_SIZE;
+    Flat *flat = (Flat *)malloc(n * sizeof(Flat));
+    if (!flat || !bench.begin(SCREEN_WIDTH, height, n))
+    {
+      Serial.printf("WORLD n=%u out of memory\n", n);
+      free(flat);
+      continue;
+    }
+    uint32_t rng = 1;
+    for (uint32_t i = 0; i < n; i++)
+    {
+      int32_t x = (rng = mix32(rng)) % SCREEN_WIDTH;
+      int32_t y = (rng = mix32(rng)) % height;
+      bench.place(ENEMY_TANK, x, y);
+      flat[i] = {x, y, false};
+    }
+    if (!bench.finish())
+    {
+      Serial.printf("WORLD n=%u out of memory\n", n);
+      free(flat);
+      continue;
+    }
+
+    int32_t step = height / TICKS + 1;
+    uint32_t woke = 0, scanned = 0;
+    uint32_t sectorUs = 0;
+    for (int t = 0; t < TICKS; t++)
+    {
+      int32_t cam = t * step;
+      uint32_t t0 = micros();
+      woke += bench.activate(0, cam + SCREEN_HEIGHT, SCREEN_WIDTH, cam + SCREEN_HEIGHT + step + WAKE_MARGIN,
+                             [](uint8_t, int32_t, int32_t, uint8_t) { return true; });
+      sectorUs += micros() - t0;
+      scanned += bench.scanned;
+    }
+
+    uint32_t flatWoke = 0;
+    uint32_t flatUs = 0;
+    for (int t = 0; t < TICKS; t++)
+    {
+      int32_t cam = t * step;
+      int32_t y0 = cam + SCREEN_HEIGHT, y1 = y0 + step + WAKE_MARGIN;
+      uint32_t t0 = micros();
+      for (uint32_t i = 0; i < n; i++)
+        if (!flat[i].awake && flat[i].y >= y0 && flat[i].y < y1)
+        {
+          flat[i].awake = true;
+          flatWoke++;
+        }
+      flatUs += micros() - t0;
+    }
+    free(flat);
+
+    Serial.printf("WORLD n=%u sectors=%u %uB sector=%.2f scan=%.2f us/tick, %u scanned/tick, woke %u/%u\n", n,
+                  bench.sectors(), bench.bytes(), (float)sectorUs / TICKS, (float)flatUs / TICKS,
+                  scanned / TICKS, woke, flatWoke);
+  }
+  bench.release();
+}
+
+// A wave in miniature: spawns five a few ticks apart, holds while the
+// stand-in enemy count is high, then waits for a kill before the next
+struct BenchWaveScript : Script
+{
+  int *alive;
+  uint8_t delay;
+  uint8_t spawned;
+  BenchWaveScript(int *a, uint8_t d) : alive(a), delay(d), spawned(0) {}
+
+  bool resume() override
+  {
+    SCRIPT_BEGIN();
+    SCRIPT_WAIT_TICKS(delay);
+    for (;;)
+    {
+      for (spawned = 0; spawned < 5; spawned++)
+      {
+        (*alive)++;
+        SCRIPT_WAIT_TICKS(3);
+      }
+      SCRIPT_WAIT_UNTIL(*alive < 400);
+      SCRIPT_WAIT_EVENT(EVENT_ENEMY_DOWN);
+    }
+    SCRIPT_END();
+  }
+};
+
+#if REWIND_ENABLED
+// Plays the first replay with history recording, rewinds 100 ticks from
+// the end, re-simulates them from the stored inputs and checks the result
+// is the state it left
+void benchmarkRewind()
+{
+  const uint32_t TICKS = 450, BACK = 100;
+  static RewindState before, after;
+  const Replay &r = replays[0];
+
+  gameTime = r.startTime;
+  game.startGame(r.seed);
+  for (int run = 0; run < r.runCount && game.state == Game::PLAYING; run++)
+  {
+    const ReplayRun &rr = r.runs[run];
+    for (int f = 0; f < rr.frames && game.state == Game::PLAYING && game.stageTick < TICKS; f++)
+    {
+      input.inject({Vec2(rr.moveX / 127.0f, rr.moveY / 127.0f), (rr.buttons & REPLAY_FIRE) != 0,
+                    (rr.buttons & REPLAY_TOUCH) != 0});
+      input.consume();
+      game.update();
+      history.afterUpdate(true);
+    }
+  }
+  if (game.state != Game::PLAYING)
+  {
+    Serial.println("REWIND replay run ended too early, skipped");
+    return;
+  }
+
+  uint32_t end = game.stageTick;
+  memset(&before, 0, sizeof(before));
+  game.captureExact(before);
+  history.print();
+
+  if (end <= BACK || !history.rewindTo(end - BACK))
+  {
+    Serial.printf("REWIND could not go back to tick %u\n", end - BACK);
+    return;
+  }
+  uint32_t restoreUs = history.restoreUs(), resimUs = history.resimUs;
+
+  for (uint32_t k = end - BACK; k < end; k++)
+  {
+    input.inject(history.inputAt(k));
+    input.consume();
+    game.update();
+  }
+  memset(&after, 0, sizeof(after));
+  game.captureExact(after);
+
+  // The rewound run has to land on exactly the state it left
+  const uint8_t *a = (const uint8_t *)&before, *b = (const uint8_t *)&after;
+  size_t firstDiff = 0;
+  while (firstDiff < sizeof(RewindState) && a[firstDiff] == b[firstDiff])
+    firstDiff++;
+  if (firstDiff == sizeof(RewindState))
+    Serial.printf("REWIND back %u ticks: restore=%u us, resim=%u us, state identical\n", BACK, restoreUs,
+                  resimUs);
+  else
+    Serial.printf("REWIND back %u ticks: restore=%u us, resim=%u us, state DIFFERS from byte %u of %u\n", BACK,
+                  restoreUs, resimUs, (unsigned)firstDiff, (unsigned)sizeof(RewindState));
+}
+#endif
+
+// Environment steps per second for a batch of headless games, split over
+// both cores by envStep and on one core by envStepRange
+void benchmarkEnvs()
+{
+  const int COUNT = 8;
+  const int STEPS = 600;
+  static EnvAction actions[COUNT];
+  static float rewards[COUNT];
+  static uint8_t dones[COUNT];
+  static EnvObservation obs[COUNT];
+
+  GameEnv *env = envCreate(COUNT, 1);
+  uint8_t *frames = (uint8_t *)malloc(COUNT * ENV_FRAME_WIDTH * ENV_FRAME_HEIGHT);
+  if (!env || !frames)
+  {
+    Serial.println("ENV out of memory");
+    envDestroy(env);
+    free(frames);
+    return;
+  }
+
+  // Same actions for both passes: hold fire, pick a new direction every
+  // half second
+  uint32_t splitUs = 0, singleUs = 0;
+  int ended = 0;
+  for (int pass = 0; pass < 2; pass++)
+  {
+    envReset(env, 1);
+    uint32_t rng = 1;
+    uint32_t t0 = micros();
+    for (int t = 0; t < STEPS; t++)
+    {
+      if (t % 15 == 0)
+        for (int i = 0; i < COUNT; i++)
+          actions[i] = {(int8_t)((rng = mix32(rng)) % 255 - 127), (int8_t)((rng = mix32(rng)) % 255 - 127),
+                        ENV_FIRE, 0};
+      if (pass == 0)
+        envStep(env, actions, rewards, dones);
+      else
+        envStepRange(env, 0, COUNT, actions, rewards, dones);
+      for (int i = 0; i < COUNT && pass == 0; i++)
+        ended += dones[i];
+    }
+    (pass == 0 ? splitUs : singleUs) = micros() - t0;
+  }
+
+  uint32_t t0 = micros();
+  envObserve(env, obs);
+  uint32_t observeUs = micros() - t0;
+  t0 = micros();
+  envRender(env, frames);
+  uint32_t renderUs = micros() - t0;
+
+  float steps = (float)COUNT * STEPS;
+  Serial.printf("ENV %d games x %d steps: %.0f steps/s batched, %.0f steps/s on one core, %d runs ended\n", COUNT,
+                STEPS, steps * 1e6f / max(splitUs, 1u), steps * 1e6f / max(singleUs, 1u), ended);
+  Serial.printf("ENV observe=%u us render=%u us per batch\n", observeUs, renderUs);
+
+  envDestroy(env);
+  free(frames);
+}
+
+// Plays the first replay rendering into the canvas with the overdraw map
+// on; host builds also save the average as OVERDRAW_PGM
+#ifndef OVERDRAW_PGM
+#define OVERDRAW_PGM "overdraw.pgm"
+#endif
+
+void benchmarkOverdraw()
+{
+  const int FRAMES = 450;
+  const Replay &r = replays[0];
+  if (!overdraw.begin(SCREEN_WIDTH, SCREEN_HEIGHT))
+  {
+    Serial.println("OVERDRAW out of memory");
+    return;
+  }
+
+  gameTime = r.startTime;
+  game.startGame(r.seed);
+  int frames = 0;
+  for (int run = 0; run < r.runCount && game.state == Game::PLAYING; run++)
+  {
+    const ReplayRun &rr = r.runs[run];
+    for (int f = 0; f < rr.frames && frames < FRAMES && game.state == Game::PLAYING; f++, frames++)
+    {
+      input.inject({Vec2(rr.moveX / 127.0f, rr.moveY / 127.0f), (rr.buttons & REPLAY_FIRE) != 0,
+                    (rr.buttons & REPLAY_TOUCH) != 0});
+      input.consume();
+      game.update();
+      game.render(false);
+    }
+  }
+
+  overdraw.print(Serial);
+  Serial.printf("OVERDRAW average %.2f writes/pixel over %u frames\n", overdraw.averageOverdraw(), overdraw.frames);
+#ifndef ARDUINO
+  if (overdraw.writePgm(OVERDRAW_PGM))
+    Serial.printf("OVERDRAW heatmap in %s, white = 8 writes/pixel\n", OVERDRAW_PGM);
+#endif
+  overdraw.end();
+}
+
+// Per-tick scheduling cost with hundreds of live scripts
+void benchmarkScripts()
+{
+  const int N = 500;
+  const int TICKS = 300;
+  static ScriptScheduler<N, 48> sched;
+  int alive = 0;
+  sched.clear();
+  for (int i = 0; i < N; i++)
+    sched.start<BenchWaveScript>(&alive, (uint8_t)(i % 16));
+
+  uint32_t total = 0;
+  for (int t = 0; t < TICKS; t++)
+  {
+    // Kills trickle in, roughly what a busy stage raises
+    if (t % 4 == 0)
+    {
+      alive = alive > 20 ? alive - 20 : 0;
+      sched.signal(EVENT_ENEMY_DOWN);
+    }
+    uint32_t t0 = micros();
+    sched.step();
+    total += micros() - t0;
+  }
+
+  Serial.printf("SCRIPT n=%d live=%d %.1f us/tick %.1f ns/script\n", N, sched.count(),
+                (float)total / TICKS, total * 1000.0f / TICKS / N);
+  sched.clear();
+}
+#endif
+
+// ============================================================================
+// ARDUINO SETUP & LOOP
+// ============================================================================
+
+// Drawn straight to the panel from a small sprite, before the full-screen
+// canvas exists
+void showSplash()
+{
+  LGFX_Sprite splash(&display);
+  splash.setColorDepth(16);
+  if (!splash.createSprite(SCREEN_WIDTH, 40))
+    return;
+  splash.fillSprite(TFT_BLACK);
+  splash.setTextColor(TFT_CYAN);
+  splash.setTextDatum(MC_DATUM);
+  splash.setTextSize(3);
+  splash.drawString("SPACE STRIKER", SCREEN_WIDTH / 2, 20);
+  splash.pushSprite(0, SCREEN_HEIGHT / 2 - 60);
+  splash.deleteSprite();
+}
+
+// Setup the title screen can do without. Everything a run needs is here,
+// so loop() finishes them before one starts.
+void initAssets()
+{
+  if (assets.begin())
+    Serial.printf("Assets: mapped bundle, %u bytes\n", (unsigned)assets.mappedSize());
+  else
+    Serial.println("Assets: no bundle, using built-in sprites");
+  spriteCache.begin(assets);
+  pinHotSprites();
+}
+
+void initSpriteTables()
+{
+  hitFlash.toward(TFT_WHITE, 200);
+  playerBulletBatch.build(spriteCache.get(SPRITE_BULLET_PLAYER));
+  enemyBulletBatch.build(spriteCache.get(SPRITE_BULLET_ENEMY));
+}
+
+void initStage()
+{
+#ifdef ARDUINO
+#if PROCEDURAL_MAP
+  StageSource *map = &proceduralMap;
+#else
+  StageSource *map = &stageSource;
+#endif
+  if (stageSource.open() && background.begin(map, SCREEN_WIDTH, SCREEN_HEIGHT))
+    Serial.printf("Stage: streaming %u columns of %upx tiles\n", background.columns(), background.tileSize());
+  else
+    Serial.println("Stage: none, using star field");
+#endif
+}
+
+void initHistory()
+{
+#if REWIND_ENABLED
+  if (history.begin())
+    Serial.printf("Rewind: %u KB, snapshot every %d ticks\n", REWIND_BYTES / 1024, REWIND_INTERVAL);
+  else
+    Serial.println("Rewind: no memory, disabled");
+#endif
+}
+
+static const DeferredStep deferredSteps[] = {
+    {"assets", initAssets},
+    {"rotations", buildRotations},
+    {"sprite tables", initSpriteTables},
+    {"paths", bakePaths},
+    {"stage", initStage},
+    {"sound", [] { sound.init(); }},
+    {"pool stats", [] { poolStore.begin(); }},
+    {"rewind", initHistory},
+};
+
+// Once the deferred steps are done: the phases, and what deferring saved
+void reportBoot()
+{
+  boot.print();
+  deferred.print();
+  uint32_t first = boot.at("first frame");
+  Serial.printf("BOOT first frame at %.1f ms; %.1f ms of setup deferred past it (%.1f ms if run up front)\n",
+                first / 1000.0f, deferred.totalUs / 1000.0f, (first + deferred.totalUs) / 1000.0f);
+}
+
+void setup()
+{
+
+  Serial.begin(115200);
+  Serial.println("Space Striker Starting...");
+  boot.mark("serial");
+
+  // Backlight
+  pinMode(46, OUTPUT);
+  digitalWrite(46, HIGH);
+
+  // Initialize display
+  display.init();
+  display.setRotation(0);
+  display.fillScreen(TFT_BLACK);
+  boot.mark("display");
+  showSplash();
+  boot.mark("splash");
+
+  // Create sprite for double buffering
+  canvas.createSprite(SCREEN_WIDTH, SCREEN_HEIGHT);
+  canvas.setColorDepth(16);
+  boot.mark("canvas");
+
+  // The title screen only needs the canvas and the game; the rest runs
+  // between its frames
+  deferred.begin(deferredSteps, sizeof(deferredSteps) / sizeof(deferredSteps[0]));
+#if CONSOLE_BUDGET_US > 0
+  console.begin(consoleCommands, sizeof(consoleCommands) / sizeof(consoleCommands[0]));
+#endif
+  game.init();
+  boot.mark("game");
+
+  Serial.println("Game initialized!");
+
+#ifdef BENCHMARK
+  deferred.finish();
+  int regressions = benchmark.run();
+  if (benchmark.unbaselined == (int)REPLAY_COUNT)
+    Serial.printf("BENCH done, no baseline: nothing compared, fill in replay_baselines.h\n");
+  else
+    Serial.printf("BENCH done, %d regression(s), %d replay(s) without a baseline\n", regressions,
+                  benchmark.unbaselined);
+  benchmarkBlits();
+  benchmarkAnimation();
+  benchmarkScripts();
+  benchmarkFormations();
+  benchmarkStageGen();
+  benchmarkWorld();
+#if REWIND_ENABLED
+  benchmarkRewind();
+#endif
+  benchmarkEnvs();
+  benchmarkOverdraw();
+  benchmarkBullets();
+  benchmarkAabb();
+  benchmark.runCacheSweep();
+  game.init();
+#endif
+}
+
+void loop()
+{
+  static unsigned long lastFrame = 0;
+  unsigned long currentTime = millis();
+
+  if (currentTime - lastFrame >= FRAME_TIME)
+  {
+    profiler.beginFrame();
+
+    // Update input
+    profiler.begin(SPAN_INPUT);
+    input.update();
+    profiler.end(SPAN_INPUT);
+
+    watchdog.beforeFrame();
+
+    // A run needs everything the title screen did without
+    if (!deferred.done() && game.state == Game::TITLE && input.getTouching())
+      deferred.finish();
 
     // Update game
+    profiler.begin(SPAN_UPDATE);
+    bool wasPlaying = game.state == Game::PLAYING;
     game.update();
+#if RECORD_REPLAYS
+    recorder.afterUpdate(wasPlaying);
+#endif
+#if REWIND_ENABLED
+    history.afterUpdate(wasPlaying);
+#endif
+    profiler.end(SPAN_UPDATE);
 
     // Update sound
+    profiler.begin(SPAN_SOUND);
     sound.update();
+    profiler.end(SPAN_SOUND);
 
     // Render
     game.render();
 
+    profiler.endFrame();
+    watchdog.afterFrame();
+    watchdog.pump();
+#if CONSOLE_BUDGET_US > 0
+    console.poll(CONSOLE_BUDGET_US);
+#endif
+
+    static bool booted = false;
+    if (!booted)
+    {
+      if (!boot.at("first frame"))
+        boot.mark("first frame");
+      deferred.step(BOOT_DEFER_BUDGET_US);
+      if (deferred.done())
+      {
+        reportBoot();
+        booted = true;
+      }
+    }
+
     lastFrame = currentTime;
 
+#if TELEMETRY_INTERVAL > 0
+    static uint32_t telemetryFrame = 0;
+    if (++telemetryFrame % TELEMETRY_INTERVAL == 0)
+      submitTelemetry(telemetryFrame);
+    telemetry.pump();
+#else
     // Debug FPS
     static unsigned long lastFpsUpdate = 0;
     static int frameCount = 0;
@@ -1191,6 +4016,7 @@ void loop()
       frameCount = 0;
       lastFpsUpdate = currentTime;
     }
+#endif
   }
 }
 
@@ -1215,18 +4041,21 @@ void loop()
  *      canvas.pushImage(x, y, width, height, player_sprite);
  *
  * 3. Add sprite sheets for animations:
- *    - Store multiple frames
- *    - Update animFrame in entity
- *    - Draw correct frame based on animFrame
+ *    - Stack the frames top to bottom in one sprite
+ *    - Add an AnimClip for it in assets.h and call entity.play(clip)
+ *    - Draw the cell sheetCell() returns for animFrame
  *
  * EXTENDING ENEMY TYPES:
  *
  * 1. Add new EntityType enum value
- * 2. Add case in spawnEnemy() with unique properties
- * 3. Add custom behavior in updateEnemies():
+ * 2. Add its row to archetypes[] (hp, size, hitbox, speed, score, drops)
+ * 3. Give it a SpriteId in assets.h, with its art in grafx.h, the
+ *    built-in table and SPRITES in tools/build_assets.py
+ * 4. Let stage cues pick it (playStageCue() maps a cue's variant to a type)
+ * 5. Add custom behavior in updateEnemies():
  *    - Sine wave movement
  *    - Circular patterns
- *    - Formation flying
+ *    - Formation flying (or fly it as a formation, see FLIGHT PATHS)
  *
  * ADDING NEW WEAPONS:
  *
@@ -0,0 +1,221 @@
+// ============================================================================
+// overdraw.h - Pixel writes per 8x8 block, for finding overdraw
+// ============================================================================
+//
+// The render path reports the box of every draw call with add(). Boxes
+// are split over the 8x8 blocks they touch, so each block ends up with
+// how many pixel writes landed in it this frame; 64 per layer of paint.
+// A call that writes only part of its box (bullet spans, circles) passes
+// the pixels it actually writes and they are spread evenly over the box.
+// Text is counted as its whole box, so HUD figures are an upper bound.
+//
+// Totals are kept per layer for the frame, and the blocks are summed over
+// frames for the heatmap: writePgm() on host builds saves the average as
+// a greyscale image. Storage is allocated by begin(), so it costs nothing
+// until someone asks for it; add() returns at once while inactive.
+
+#pragma once
+
+#include <Arduino.h>
+
+#ifndef ARDUINO
+#include <stdio.h>
+#endif
+
+#define OVERDRAW_BLOCK 8
+
+// Where a write came from, in drawing order
+enum OverdrawLayer
+{
+  OD_CLEAR,
+  OD_BACKGROUND,
+  OD_SPRITES,
+  OD_BULLETS,
+  OD_EFFECTS, // explosions and particles
+  OD_HUD,
+  OD_CONTROLS, // on-screen joystick and fire button
+  OD_LAYERS
+};
+
+class OverdrawMap
+{
+private:
+  uint16_t *frame = nullptr; // writes per block this frame
+  uint32_t *sum = nullptr;   // writes per block over every frame since begin()
+  int columns = 0, rows = 0;
+  int width = 0, height = 0;
+
+public:
+  bool active = false;
+  uint32_t frames = 0;
+  uint32_t layerWrites[OD_LAYERS] = {}; // this frame
+
+  static const char *layerName(OverdrawLayer l)
+  {
+    static const char *const names[OD_LAYERS] = {"clear", "background", "sprites", "bullets",
+                                                 "effects", "hud", "controls"};
+    return names[l];
+  }
+
+  // Allocates the maps and starts counting from zero
+  bool begin(int screenWidth, int screenHeight)
+  {
+    width = screenWidth;
+    height = screenHeight;
+    columns = (width + OVERDRAW_BLOCK - 1) / OVERDRAW_BLOCK;
+    rows = (height + OVERDRAW_BLOCK - 1) / OVERDRAW_BLOCK;
+    if (!frame)
+      frame = (uint16_t *)malloc(columns * rows * sizeof(uint16_t));
+    if (!sum)
+      sum = (uint32_t *)malloc(columns * rows * sizeof(uint32_t));
+    if (!frame || !sum)
+    {
+      end();
+      return false;
+    }
+    memset(sum, 0, columns * rows * sizeof(uint32_t));
+    frames = 0;
+    active = true;
+    beginFrame();
+    return true;
+  }
+
+  // Stops counting and frees the maps
+  void end()
+  {
+    free(frame);
+    free(sum);
+    frame = nullptr;
+    sum = nullptr;
+    active = false;
+  }
+
+  void beginFrame()
+  {
+    if (!active)
+      return;
+    memset(frame, 0, columns * rows * sizeof(uint16_t));
+    for (int l = 0; l < OD_LAYERS; l++)
+      layerWrites[l] = 0;
+  }
+
+  void endFrame()
+  {
+    if (active)
+      frames++;
+  }
+
+  // A draw call covering w x h at x, y that writes pixels of it (all of
+  // them by default). Clipped to the screen.
+  void add(OverdrawLayer layer, int x, int y, int w, int h, int32_t pixels = -1)
+  {
+    if (!active || w <= 0 || h <= 0)
+      return;
+    int32_t area = w * h;
+    if (pixels < 0)
+      pixels = area;
+    int x0 = max(x, 0), x1 = min(x + w, width);
+    int y0 = max(y, 0), y1 = min(y + h, height);
+    if (x0 >= x1 || y0 >= y1 || !pixels)
+      return;
+
+    for (int by = y0 / OVERDRAW_BLOCK; by <= (y1 - 1) / OVERDRAW_BLOCK; by++)
+    {
+      int oy = min(y1, (by + 1) * OVERDRAW_BLOCK) - max(y0, by * OVERDRAW_BLOCK);
+      for (int bx = x0 / OVERDRAW_BLOCK; bx <= (x1 - 1) / OVERDRAW_BLOCK; bx++)
+      {
+        int ox = min(x1, (bx + 1) * OVERDRAW_BLOCK) - max(x0, bx * OVERDRAW_BLOCK);
+        uint32_t n = pixels == area ? ox * oy : (uint32_t)((int64_t)ox * oy * pixels / area);
+        int i = by * columns + bx;
+        frame[i] = frame[i] + n > 0xFFFF ? 0xFFFF : frame[i] + n;
+        sum[i] += n;
+        layerWrites[layer] += n;
+      }
+    }
+  }
+
+  // A filled circle, as its area spread over its box
+  void addCircle(OverdrawLayer layer, int cx, int cy, int r)
+  {
+    add(layer, cx - r, cy - r, 2 * r + 1, 2 * r + 1, (int32_t)(PI * r * r + 0.5f));
+  }
+
+  // Writes per pixel over the screen this frame, 1.0 = each pixel once
+  float overdraw() const
+  {
+    uint32_t total = 0;
+    for (int l = 0; l < OD_LAYERS; l++)
+      total += layerWrites[l];
+    return width ? (float)total / (width * height) : 0;
+  }
+
+  // The same averaged over every frame since begin()
+  float averageOverdraw() const
+  {
+    uint64_t total = 0;
+    for (int i = 0; i < columns * rows; i++)
+      total += sum[i];
+    return frames ? (float)total / frames / (width * height) : 0;
+  }
+
+  // Blocks written at least times over this frame, and the busiest one
+  int blocksOver(int times, int *worstBlock = nullptr, uint32_t *worstWrites = nullptr) const
+  {
+    int n = 0, worst = 0;
+    for (int i = 0; i < columns * rows; i++)
+    {
+      if (frame[i] >= times * OVERDRAW_BLOCK * OVERDRAW_BLOCK)
+        n++;
+      if (frame[i] > frame[worst])
+        worst = i;
+    }
+    if (worstBlock)
+      *worstBlock = worst;
+    if (worstWrites)
+      *worstWrites = frame[worst];
+    return n;
+  }
+
+  // Summary of the last frame to anything with a printf (Serial, the console)
+  template <class Out>
+  void print(Out &out) const
+  {
+    if (!active)
+      return;
+    int worst;
+    uint32_t worstWrites;
+    int over = blocksOver(4, &worst, &worstWrites);
+    out.printf("OVERDRAW %.2f writes/pixel, %d of %d blocks 4x or more, worst %.1fx at %d,%d\n", overdraw(), over,
+               columns * rows, (float)worstWrites / (OVERDRAW_BLOCK * OVERDRAW_BLOCK),
+               worst % columns * OVERDRAW_BLOCK, worst / columns * OVERDRAW_BLOCK);
+    for (int l = 0; l < OD_LAYERS; l++)
+      out.printf("OVERDRAW   %-10s %6u px %5.2fx\n", layerName((OverdrawLayer)l), layerWrites[l],
+                 (float)layerWrites[l] / (width * height));
+  }
+
+#ifndef ARDUINO
+  // The average over every frame since begin() as a binary PGM, one grey
+  // level per block scaled so white is maxTimes writes per pixel
+  bool writePgm(const char *path, int maxTimes = 8) const
+  {
+    if (!active || !frames)
+      return false;
+    FILE *f = fopen(path, "wb");
+    if (!f)
+      return false;
+    fprintf(f, "P5\n%d %d\n255\n", width, height);
+    uint8_t line[1024];
+    for (int y = 0; y < height; y++)
+    {
+      for (int x = 0; x < width && x < (int)sizeof(line); x++)
+      {
+        uint32_t s = sum[(y / OVERDRAW_BLOCK) * columns + x / OVERDRAW_BLOCK];
+        uint64_t v = (uint64_t)s * 255 / ((uint64_t)frames * maxTimes * OVERDRAW_BLOCK * OVERDRAW_BLOCK);
+        line[x] = v > 255 ? 255 : v;
+      }
+      fwrite(line, 1, min(width, (int)sizeof(line)), f);
+    }
+    return fclose(f) == 0;
+  }
+#endif
+};
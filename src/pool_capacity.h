@@ -0,0 +1,28 @@
+// ============================================================================
+// pool_capacity.h - Entity pool capacities
+// ============================================================================
+//
+// Regenerate from measured high-water marks with tools/pool_sizing.py
+// rather than editing by hand. Any value can still be overridden with a
+// -D build flag.
+
+#pragma once
+
+#ifndef MAX_ENEMIES
+#define MAX_ENEMIES 20
+#endif
+#ifndef MAX_PLAYER_BULLETS
+#define MAX_PLAYER_BULLETS 30
+#endif
+#ifndef MAX_ENEMY_BULLETS
+#define MAX_ENEMY_BULLETS 40
+#endif
+#ifndef MAX_POWERUPS
+#define MAX_POWERUPS 5
+#endif
+#ifndef MAX_EXPLOSIONS
+#define MAX_EXPLOSIONS 10
+#endif
+#ifndef MAX_PARTICLES
+#define MAX_PARTICLES 50
+#endif
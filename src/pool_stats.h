@@ -0,0 +1,111 @@
+// ============================================================================
+// pool_stats.h - Entity pool high-water marks and overflow counts
+// ============================================================================
+//
+// Every run's peak occupancy and failed spawns are printed as a POOLS line
+// and folded into lifetime totals kept in NVS. tools/pool_sizing.py turns
+// a pile of POOLS lines into a new pool_capacity.h; it skips lifetime
+// totals and runs marked tainted.
+
+#pragma once
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include "pool_capacity.h"
+
+enum EntityPool
+{
+  POOL_ENEMIES,
+  POOL_PLAYER_BULLETS,
+  POOL_ENEMY_BULLETS,
+  POOL_POWERUPS,
+  POOL_EXPLOSIONS,
+  POOL_PARTICLES,
+  POOL_COUNT
+};
+
+static const uint16_t poolCapacity[POOL_COUNT] = {
+    MAX_ENEMIES, MAX_PLAYER_BULLETS, MAX_ENEMY_BULLETS,
+    MAX_POWERUPS, MAX_EXPLOSIONS, MAX_PARTICLES};
+
+struct PoolStats
+{
+  uint16_t highWater;
+  uint16_t capacity;
+  uint32_t overflows;
+};
+
+// POOLS <source> cap=..  hw=..  of=..   one comma separated value per pool
+static void printPoolStats(const char *source, const PoolStats *stats)
+{
+  Serial.printf("POOLS %s cap=", source);
+  for (int p = 0; p < POOL_COUNT; p++)
+    Serial.printf(p ? ",%u" : "%u", stats[p].capacity);
+  Serial.print(" hw=");
+  for (int p = 0; p < POOL_COUNT; p++)
+    Serial.printf(p ? ",%u" : "%u", stats[p].highWater);
+  Serial.print(" of=");
+  for (int p = 0; p < POOL_COUNT; p++)
+    Serial.printf(p ? ",%u" : "%u", stats[p].overflows);
+  Serial.println();
+}
+
+class PoolStatsStore
+{
+private:
+  // Lifetime peaks and overflow totals. Flash is only written at the end
+  // of a run, never per frame.
+  struct Stored
+  {
+    uint32_t runs;
+    PoolStats pools[POOL_COUNT];
+  };
+
+  Stored lifetime;
+  Preferences prefs;
+
+public:
+  const char *label = "run";
+  bool persist = true;
+
+  void begin()
+  {
+    memset(&lifetime, 0, sizeof(lifetime));
+    prefs.begin("pools", false);
+    if (prefs.getBytesLength("stats") == sizeof(lifetime))
+      prefs.getBytes("stats", &lifetime, sizeof(lifetime));
+
+    // Peaks measured against other capacities do not compare, start over
+    for (int p = 0; p < POOL_COUNT; p++)
+    {
+      if (lifetime.pools[p].capacity != poolCapacity[p])
+      {
+        memset(&lifetime, 0, sizeof(lifetime));
+        break;
+      }
+    }
+    for (int p = 0; p < POOL_COUNT; p++)
+      lifetime.pools[p].capacity = poolCapacity[p];
+
+    char source[24];
+    snprintf(source, sizeof(source), "lifetime/%u", lifetime.runs);
+    printPoolStats(source, lifetime.pools);
+  }
+
+  // A tainted run (forced spawns, capped pools) is printed as "tainted"
+  // for the record but kept out of the lifetime totals and sizing
+  void recordRun(const PoolStats *run, bool tainted = false)
+  {
+    printPoolStats(tainted ? "tainted" : label, run);
+    if (!persist || tainted)
+      return;
+
+    lifetime.runs++;
+    for (int p = 0; p < POOL_COUNT; p++)
+    {
+      lifetime.pools[p].highWater = max(lifetime.pools[p].highWater, run[p].highWater);
+      lifetime.pools[p].overflows += run[p].overflows;
+    }
+    prefs.putBytes("stats", &lifetime, sizeof(lifetime));
+  }
+};
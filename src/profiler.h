@@ -0,0 +1,91 @@
+// ============================================================================
+// profiler.h - Per-frame span timing and work counters
+// ============================================================================
+//
+// Each frame is split into a fixed set of spans timed with micros(). Spans
+// accumulate, so a span may be entered several times in one frame. Counters
+// track work done (collision pairs, pixels, bytes) alongside the timings.
+
+#pragma once
+
+#include <Arduino.h>
+
+enum ProfileSpan
+{
+  SPAN_INPUT,
+  SPAN_UPDATE,
+  SPAN_SOUND,
+  SPAN_DRAW,
+  SPAN_PUSH,
+  SPAN_COUNT
+};
+
+// Work counters, also reset every frame
+enum ProfileCounter
+{
+  COUNT_COLLISION_TESTS,
+  COUNT_PIXELS_DRAWN,
+  COUNT_BYTES_FLUSHED,
+  COUNT_CULLED,     // entities skipped by the visibility pass
+  COUNT_FAST_DRAWS, // sprites blitted without clipping
+  COUNTER_COUNT
+};
+
+class FrameProfiler
+{
+private:
+  uint32_t frameStart;
+  uint32_t frameUs;
+  uint32_t spanStart[SPAN_COUNT];
+  uint32_t spanUs[SPAN_COUNT];
+  uint32_t counters[COUNTER_COUNT];
+
+public:
+  void beginFrame()
+  {
+    for (int i = 0; i < SPAN_COUNT; i++)
+      spanUs[i] = 0;
+    for (int i = 0; i < COUNTER_COUNT; i++)
+      counters[i] = 0;
+    frameStart = micros();
+  }
+
+  uint32_t endFrame()
+  {
+    frameUs = micros() - frameStart;
+    return frameUs;
+  }
+
+  // Bit per span left untimed (it then reads 0), e.g. to see what the
+  // micros() calls themselves cost
+  uint32_t disabled = 0;
+
+  void begin(ProfileSpan s)
+  {
+    if (!(disabled & (1u << s)))
+      spanStart[s] = micros();
+  }
+  void end(ProfileSpan s)
+  {
+    if (!(disabled & (1u << s)))
+      spanUs[s] += micros() - spanStart[s];
+  }
+
+  void count(ProfileCounter c, uint32_t n = 1) { counters[c] += n; }
+
+  uint32_t span(ProfileSpan s) const { return spanUs[s]; }
+  uint32_t counter(ProfileCounter c) const { return counters[c]; }
+  uint32_t frame() const { return frameUs; }
+
+  static const char *spanName(ProfileSpan s)
+  {
+    static const char *const names[SPAN_COUNT] = {"input", "update", "sound", "draw", "push"};
+    return names[s];
+  }
+
+  static const char *counterName(ProfileCounter c)
+  {
+    static const char *const names[COUNTER_COUNT] = {"collisions", "pixels", "flushed", "culled", "fastdraws"};
+    return names[c];
+  }
+};
@@ -0,0 +1,29 @@
+// ============================================================================
+// replay_baselines.h - Stored frame time baselines for the replay benchmark
+// ============================================================================
+//
+// Per replay p50/p99 of update + draw time in microseconds, measured on the
+// target board with the bench environment. The benchmark prints a ready to
+// paste line for every replay; commit the new numbers whenever a change is
+// meant to move them. A zero entry means no baseline has been recorded yet,
+// so that replay is reported but not compared.
+
+#pragma once
+
+#include <Arduino.h>
+
+// Allowed slowdown against the baseline before a replay counts as a regression
+#define BENCH_TOLERANCE_PCT 10
+
+struct ReplayBaseline
+{
+  const char *replay;
+  uint32_t p50Us;
+  uint32_t p99Us;
+};
+
+const ReplayBaseline replayBaselines[] = {
+    {"sweep", 0, 0},
+    {"camp", 0, 0},
+    {"dodge", 0, 0},
+};
@@ -0,0 +1,79 @@
+// ============================================================================
+// replays.h - Recorded input for the replay benchmark
+// ============================================================================
+//
+// A replay is the run seed, the simulation clock at startGame() and the
+// per-frame input, run-length encoded. Build with RECORD_REPLAYS set to 1
+// and the game prints each finished run over Serial in this format, ready
+// to paste below.
+//
+// The replays committed here are scripted rather than played by hand:
+// "sweep" strafes across the screen firing, "camp" sits still firing, and
+// "dodge" only moves so enemies and their bullets pile up.
+
+#pragma once
+
+#include <Arduino.h>
+
+#define REPLAY_FIRE 0x01
+#define REPLAY_TOUCH 0x02
+
+// One stretch of identical input samples. Stick axes are in 1/127 steps.
+struct ReplayRun
+{
+  uint16_t frames;
+  int8_t moveX;
+  int8_t moveY;
+  uint8_t buttons;
+};
+
+struct Replay
+{
+  const char *name;
+  uint32_t seed;
+  uint32_t startTime;
+  const ReplayRun *runs;
+  uint16_t runCount;
+};
+
+#define FT (REPLAY_FIRE | REPLAY_TOUCH)
+
+const ReplayRun replay_sweep_runs[] PROGMEM = {
+    {30, 0, 0, FT},
+    {40, -127, 0, FT}, {80, 127, 0, FT}, {80, -127, 0, FT}, {80, 127, 0, FT},
+    {40, -127, 0, FT}, {20, 0, -127, FT}, {20, 0, 127, FT},
+    {40, -127, 0, FT}, {80, 127, 0, FT}, {80, -127, 0, FT}, {80, 127, 0, FT},
+    {40, -127, 0, FT}, {20, 0, -127, FT}, {20, 0, 127, FT},
+    {40, -127, 0, FT}, {80, 127, 0, FT}, {80, -127, 0, FT}, {80, 127, 0, FT},
+    {40, -127, 0, FT}, {20, 0, -127, FT}, {20, 0, 127, FT},
+    {40, -90, -90, FT}, {40, 90, 90, FT}, {40, 90, -90, FT}, {40, -90, 90, FT},
+    {200, 0, 0, FT},
+};
+
+const ReplayRun replay_camp_runs[] PROGMEM = {
+    {1800, 0, 0, FT},
+};
+
+const ReplayRun replay_dodge_runs[] PROGMEM = {
+    {60, 0, 0, 0},
+    {25, -127, 0, REPLAY_TOUCH}, {50, 127, 0, REPLAY_TOUCH}, {25, -127, 0, REPLAY_TOUCH},
+    {30, 0, 0, 0}, {15, 0, -127, REPLAY_TOUCH}, {15, 0, 127, REPLAY_TOUCH},
+    {25, -127, 0, REPLAY_TOUCH}, {50, 127, 0, REPLAY_TOUCH}, {25, -127, 0, REPLAY_TOUCH},
+    {30, 0, 0, 0}, {15, 0, -127, REPLAY_TOUCH}, {15, 0, 127, REPLAY_TOUCH},
+    {25, -127, 0, REPLAY_TOUCH}, {50, 127, 0, REPLAY_TOUCH}, {25, -127, 0, REPLAY_TOUCH},
+    {30, 0, 0, 0}, {15, 0, -127, REPLAY_TOUCH}, {15, 0, 127, REPLAY_TOUCH},
+    {600, 0, 0, 0},
+};
+
+#undef FT
+
+#define REPLAY_ENTRY(name, seed, start) \
+  {#name, seed, start, replay_##name##_runs, sizeof(replay_##name##_runs) / sizeof(ReplayRun)}
+
+const Replay replays[] = {
+    REPLAY_ENTRY(sweep, 0x5EED0001, 10000),
+    REPLAY_ENTRY(camp, 0x5EED0002, 10000),
+    REPLAY_ENTRY(dodge, 0x5EED0003, 10000),
+};
+
+#define REPLAY_COUNT (sizeof(replays) / sizeof(Replay))
@@ -0,0 +1,246 @@
+// ============================================================================
+// rewind.h - Snapshot history kept as XOR/RLE deltas
+// ============================================================================
+//
+// Each pushed snapshot is XORed with the one before it. Whatever did not
+// change becomes zero bytes, and the delta codec stores only the runs
+// that are not: (zero run, literal run, literal bytes), lengths as
+// varints. Only the newest snapshot is kept whole. Older ones are
+// recovered by walking back from it, since s[k-1] = s[k] ^ delta[k].
+// So the oldest delta can be dropped at any time without a keyframe, and
+// stepping back n snapshots costs n decodes.
+//
+// Deltas live in one byte ring (PSRAM when present). When a new delta
+// does not fit, the oldest ones are evicted until it does.
+
+#pragma once
+
+#include <Arduino.h>
+
+// ---- Delta codec -----------------------------------------------------------
+
+static inline uint8_t *putVarint(uint8_t *p, uint32_t v)
+{
+  while (v >= 0x80)
+  {
+    *p++ = v | 0x80;
+    v >>= 7;
+  }
+  *p++ = v;
+  return p;
+}
+
+static inline const uint8_t *getVarint(const uint8_t *p, uint32_t &v)
+{
+  v = 0;
+  for (int shift = 0;; shift += 7)
+  {
+    uint8_t b = *p++;
+    v |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80))
+      return p;
+  }
+}
+
+// Worst case output for n input bytes
+static inline size_t deltaBound(size_t n)
+{
+  return n + n / 2 + 16;
+}
+
+// Encodes cur ^ prev into out (deltaBound(n) bytes), returns its length
+static size_t encodeDelta(const uint8_t *cur, const uint8_t *prev, size_t n, uint8_t *out)
+{
+  uint8_t *p = out;
+  size_t i = 0;
+  while (i < n)
+  {
+    size_t zeros = i;
+    while (i < n && cur[i] == prev[i])
+      i++;
+    if (i == n)
+      break; // trailing zeros are implied
+    zeros = i - zeros;
+
+    // A literal run ends at the first pair of unchanged bytes; a single
+    // one is cheaper to carry than to split on
+    size_t start = i;
+    while (i < n && (cur[i] != prev[i] || (i + 1 < n && cur[i + 1] != prev[i + 1])))
+      i++;
+    p = putVarint(p, zeros);
+    p = putVarint(p, i - start);
+    for (size_t k = start; k < i; k++)
+      *p++ = cur[k] ^ prev[k];
+  }
+  return p - out;
+}
+
+// state ^= the delta, which turns one end of it into the other
+static void applyDelta(uint8_t *state, size_t n, const uint8_t *delta, size_t len)
+{
+  const uint8_t *p = delta, *end = delta + len;
+  size_t i = 0;
+  while (p < end)
+  {
+    uint32_t zeros, count;
+    p = getVarint(p, zeros);
+    p = getVarint(p, count);
+    i += zeros;
+    for (uint32_t k = 0; k < count && i < n; k++)
+      state[i++] ^= *p++;
+  }
+}
+
+// ---- History ---------------------------------------------------------------
+
+// N is the most snapshots remembered, however small their deltas
+template <int N>
+class RewindBuffer
+{
+private:
+  struct Entry
+  {
+    uint32_t tick;
+    uint32_t time;
+    uint32_t offset;
+    uint32_t length;
+  };
+
+  Entry entries[N];
+  int first = 0; // oldest
+  int count = 0;
+
+  uint8_t *ring = nullptr;
+  uint32_t ringBytes = 0;
+  uint32_t writePos = 0;
+  uint8_t *latest = nullptr;
+  uint8_t *scratch = nullptr;
+  size_t size = 0;
+
+  static void *allocate(size_t bytes)
+  {
+#ifdef BOARD_HAS_PSRAM
+    return ps_malloc(bytes);
+#else
+    return malloc(bytes);
+#endif
+  }
+
+  Entry &at(int i) { return entries[(first + i) % N]; }
+
+  void evictOldest()
+  {
+    first = (first + 1) % N;
+    count--;
+  }
+
+  // Finds room for len bytes, evicting old deltas as needed. Live data
+  // runs from the oldest entry's offset round to writePos.
+  uint32_t reserve(uint32_t len)
+  {
+    while (true)
+    {
+      if (!count)
+        return 0;
+      if (count < N)
+      {
+        uint32_t tail = at(0).offset;
+        if (writePos > tail)
+        {
+          if (writePos + len <= ringBytes)
+            return writePos;
+          if (len <= tail)
+            return 0;
+        }
+        else if (writePos + len <= tail)
+          return writePos;
+      }
+      evictOldest();
+    }
+  }
+
+public:
+  uint32_t lastPushUs = 0;
+  uint32_t maxPushUs = 0;
+  uint32_t lastRestoreUs = 0;
+
+  bool begin(size_t snapshotBytes, uint32_t bytes)
+  {
+    size = snapshotBytes;
+    ringBytes = bytes;
+    ring = (uint8_t *)allocate(bytes);
+    latest = (uint8_t *)allocate(size);
+    scratch = (uint8_t *)allocate(deltaBound(size));
+    if (!ring || !latest || !scratch || deltaBound(size) > bytes)
+    {
+      free(ring);
+      free(latest);
+      free(scratch);
+      ring = latest = scratch = nullptr;
+      return false;
+    }
+    clear();
+    return true;
+  }
+
+  bool active() const { return ring != nullptr; }
+
+  void clear()
+  {
+    first = count = 0;
+    writePos = 0;
+    if (latest)
+      memset(latest, 0, size);
+  }
+
+  int snapshots() const { return count; }
+  uint32_t oldestTick() { return count ? at(0).tick : 0; }
+  uint32_t newestTick() { return count ? at(count - 1).tick : 0; }
+
+  uint32_t usedBytes()
+  {
+    uint32_t n = 0;
+    for (int i = 0; i < count; i++)
+      n += at(i).length;
+    return n;
+  }
+
+  // Adds a snapshot taken at tick (time is the simulation clock then)
+  void push(uint32_t tick, uint32_t time, const void *snapshot)
+  {
+    uint32_t t0 = micros();
+    const uint8_t *cur = (const uint8_t *)snapshot;
+    uint32_t len = encodeDelta(cur, latest, size, scratch);
+    uint32_t pos = reserve(len);
+    memcpy(ring + pos, scratch, len);
+    writePos = pos + len;
+    entries[(first + count) % N] = {tick, time, pos, len};
+    count++;
+    memcpy(latest, cur, size);
+    lastPushUs = micros() - t0;
+    maxPushUs = max(maxPushUs, lastPushUs);
+  }
+
+  // Rebuilds the newest snapshot taken at or before tick into out and
+  // drops everything newer, so history carries on from there. Returns
+  // false when tick is older than anything kept.
+  bool rewind(uint32_t tick, void *out, uint32_t &snapTick, uint32_t &snapTime)
+  {
+    uint32_t t0 = micros();
+    int target = count - 1;
+    while (target >= 0 && at(target).tick > tick)
+      target--;
+    if (target < 0)
+      return false;
+
+    for (int i = count - 1; i > target; i--)
+      applyDelta(latest, size, ring + at(i).offset, at(i).length);
+    count = target + 1;
+    writePos = at(target).offset + at(target).length;
+    memcpy(out, latest, size);
+    snapTick = at(target).tick;
+    snapTime = at(target).time;
+    lastRestoreUs = micros() - t0;
+    return true;
+  }
+};
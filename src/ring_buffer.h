@@ -0,0 +1,117 @@
+// ============================================================================
+// ring_buffer.h - Lock-free single-producer / single-consumer ring buffer
+// ============================================================================
+//
+// One task pushes, one task pops, no locks. Head and tail live on separate
+// cache lines so the producer and consumer cores do not thrash each other.
+// Capacity must be a power of two; one slot is NOT sacrificed because the
+// indices run freely and are masked on access.
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+template <typename T, size_t N>
+class SpscRing
+{
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+  SpscRing() : head(0), tail(0) {}
+
+  // ---- Producer side ----
+
+  bool push(const T &item)
+  {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    if (h - cachedTail >= N)
+    {
+      cachedTail = tail.load(std::memory_order_acquire);
+      if (h - cachedTail >= N)
+        return false;
+    }
+    slots[h & MASK] = item;
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Pushes up to count items, returns how many fit
+  size_t pushBatch(const T *items, size_t count)
+  {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    size_t space = N - (h - cachedTail);
+    if (space < count)
+    {
+      cachedTail = tail.load(std::memory_order_acquire);
+      space = N - (h - cachedTail);
+    }
+    if (count > space)
+      count = space;
+    for (size_t i = 0; i < count; i++)
+      slots[(h + i) & MASK] = items[i];
+    head.store(h + (uint32_t)count, std::memory_order_release);
+    return count;
+  }
+
+  // ---- Consumer side ----
+
+  bool pop(T &item)
+  {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    if (t == cachedHead)
+    {
+      cachedHead = head.load(std::memory_order_acquire);
+      if (t == cachedHead)
+        return false;
+    }
+    item = slots[t & MASK];
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Pops up to maxCount items, returns how many were read
+  size_t popBatch(T *items, size_t maxCount)
+  {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    size_t avail = cachedHead - t;
+    if (avail < maxCount)
+    {
+      cachedHead = head.load(std::memory_order_acquire);
+      avail = cachedHead - t;
+    }
+    if (maxCount > avail)
+      maxCount = avail;
+    for (size_t i = 0; i < maxCount; i++)
+      items[i] = slots[(t + i) & MASK];
+    tail.store(t + (uint32_t)maxCount, std::memory_order_release);
+    return maxCount;
+  }
+
+  // ---- Either side (approximate while the other side is running) ----
+
+  size_t size() const
+  {
+    return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+  }
+  bool empty() const { return size() == 0; }
+  static constexpr size_t capacity() { return N; }
+
+private:
+  static const uint32_t MASK = N - 1;
+
+  // Producer-owned line: write index plus its stale view of the tail
+  alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> head;
+  uint32_t cachedTail = 0;
+
+  // Consumer-owned line: read index plus its stale view of the head
+  alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> tail;
+  uint32_t cachedHead = 0;
+
+  alignas(CACHE_LINE_SIZE) T slots[N];
+};
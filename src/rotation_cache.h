@@ -0,0 +1,93 @@
+// ============================================================================
+// rotation_cache.h - Pre-rotated sprite variants
+// ============================================================================
+//
+// Rotating a sprite while drawing costs a trig-driven resample per pixel,
+// far too slow for every enemy every frame. Instead each registered sprite
+// is rotated once at startup into ROTATION_STEPS headings, and the
+// renderer picks the nearest one - a plain blit of the same size.
+//
+// Variants keep the source size, so pixels rotated past the corners are
+// clipped; the art is drawn inside its inscribed circle, which keeps that
+// harmless. Step 0 is the art as drawn, steps turn clockwise on screen.
+
+#pragma once
+
+#include <Arduino.h>
+#include "assets.h"
+
+#ifndef ROTATION_STEPS
+#define ROTATION_STEPS 16
+#endif
+
+class RotationCache
+{
+private:
+  uint16_t *variants[SPRITE_COUNT] = {};
+  uint16_t width[SPRITE_COUNT] = {};
+  uint16_t height[SPRITE_COUNT] = {};
+
+public:
+  // Resamples src into every heading, nearest neighbour. Needs decoded
+  // pixels, so pass what AssetCache::get() returns.
+  bool build(SpriteId id, const SpriteInfo &src)
+  {
+    if (!src.pixels)
+      return false;
+    size_t pixels = (size_t)src.width * src.height;
+    free(variants[id]);
+#ifdef BOARD_HAS_PSRAM
+    variants[id] = (uint16_t *)ps_malloc(pixels * 2 * ROTATION_STEPS);
+#else
+    variants[id] = (uint16_t *)malloc(pixels * 2 * ROTATION_STEPS);
+#endif
+    if (!variants[id])
+      return false;
+    width[id] = src.width;
+    height[id] = src.height;
+
+    float cx = (src.width - 1) / 2.0f;
+    float cy = (src.height - 1) / 2.0f;
+    for (int step = 0; step < ROTATION_STEPS; step++)
+    {
+      float a = step * 2 * PI / ROTATION_STEPS;
+      float c = cosf(a), s = sinf(a);
+      uint16_t *out = variants[id] + step * pixels;
+      for (int y = 0; y < src.height; y++)
+        for (int x = 0; x < src.width; x++)
+        {
+          // Inverse rotation: where in the source this pixel came from
+          float dx = x - cx, dy = y - cy;
+          int sx = (int)lroundf(cx + dx * c + dy * s);
+          int sy = (int)lroundf(cy - dx * s + dy * c);
+          bool inside = sx >= 0 && sx < src.width && sy >= 0 && sy < src.height;
+          *out++ = inside ? src.pixels[sy * src.width + sx] : 0x0000;
+        }
+    }
+    return true;
+  }
+
+  // Pixels for a heading step, or nullptr if id was never built
+  const uint16_t *variant(SpriteId id, int step) const
+  {
+    if (!variants[id])
+      return nullptr;
+    step = ((step % ROTATION_STEPS) + ROTATION_STEPS) % ROTATION_STEPS;
+    return variants[id] + (size_t)step * width[id] * height[id];
+  }
+
+  uint32_t bytes(SpriteId id) const
+  {
+    return variants[id] ? (uint32_t)width[id] * height[id] * 2 * ROTATION_STEPS : 0;
+  }
+
+  // Nearest step for art that faces down the screen (+y) at step 0
+  static int stepFor(float vx, float vy)
+  {
+    if (vx == 0 && vy == 0)
+      return 0;
+    float a = atan2f(-vx, vy);
+    int step = (int)lroundf(a * ROTATION_STEPS / (2 * PI));
+    return (step + ROTATION_STEPS) % ROTATION_STEPS;
+  }
+};
@@ -0,0 +1,180 @@
+// ============================================================================
+// script.h - Stackless coroutines for stage and wave scripts
+// ============================================================================
+//
+// A script is a class with a resume() body written as straight-line code
+// between SCRIPT_BEGIN() and SCRIPT_END(). The wait macros save where it
+// stopped and return; the next resume() jumps back there through a switch
+// (the protothread trick), so a sequence like "spawn five, wait until they
+// are gone, wait two seconds, spawn the next lot" reads top to bottom
+// instead of as a pile of state flags.
+//
+// Scripts live in fixed-size frames inside ScriptScheduler, never on the
+// heap, and are resumed once per simulation tick by step(). Scripts that
+// are only counting down ticks or waiting for an event are skipped without
+// calling into them.
+//
+// Because the body returns at every wait, locals do not survive one; keep
+// anything that must as members. Only one wait per source line.
+
+#pragma once
+
+#include <Arduino.h>
+#include <new>
+#include <utility>
+
+#define SCRIPT_BEGIN() \
+  switch (line)        \
+  {                    \
+  case 0:
+
+#define SCRIPT_END() \
+  }                  \
+  return false;
+
+// Resume after n more ticks (0 or 1: the next tick)
+#define SCRIPT_WAIT_TICKS(n) \
+  do                         \
+  {                          \
+    waitTicks = (n);         \
+    line = __LINE__;         \
+    return true;             \
+  case __LINE__:;            \
+  } while (0)
+
+#define SCRIPT_YIELD() SCRIPT_WAIT_TICKS(1)
+
+// Checked straight away, then once per tick until true. Falls into its own
+// case label on purpose; a "fall through" comment would not survive macro
+// expansion, so the attribute says so.
+#define SCRIPT_WAIT_UNTIL(cond)   \
+  do                              \
+  {                               \
+    line = __LINE__;              \
+    __attribute__((fallthrough)); \
+  case __LINE__:                  \
+    if (!(cond))                  \
+      return true;                \
+  } while (0)
+
+// Resume on the first tick any of the event bits in mask was raised;
+// the ones that were are left in fired
+#define SCRIPT_WAIT_EVENT(mask) \
+  do                            \
+  {                             \
+    waitEvents = (mask);        \
+    line = __LINE__;            \
+    return true;                \
+  case __LINE__:;               \
+  } while (0)
+
+class Script
+{
+public:
+  uint16_t line = 0;       // resume point, 0 = start
+  uint16_t waitTicks = 0;  // ticks left before the next resume
+  uint32_t waitEvents = 0; // event bits that resume it, 0 = none
+  uint32_t fired = 0;      // bits that ended the last event wait
+
+  virtual ~Script() {}
+
+  // Runs to the next wait. Returns false once the script has finished.
+  virtual bool resume() = 0;
+};
+
+// Up to N scripts of at most FRAME bytes each
+template <int N, int FRAME>
+class ScriptScheduler
+{
+private:
+  alignas(8) uint8_t frames[N][FRAME];
+  Script *live[N] = {};
+  bool fresh[N] = {};
+  uint32_t pending = 0;
+  int cursor = N; // slot step() is at, N outside step()
+
+public:
+  uint32_t overflows = 0;
+
+  ~ScriptScheduler() { clear(); }
+
+  // Starts a script, or returns nullptr (and counts it) when every frame
+  // is taken. A script started from inside step() first runs next tick.
+  template <class T, class... Args>
+  T *start(Args &&...args)
+  {
+    static_assert(sizeof(T) <= FRAME, "script does not fit a frame, raise FRAME");
+    static_assert(alignof(T) <= 8, "script needs stronger alignment than a frame has");
+    for (int i = 0; i < N; i++)
+    {
+      if (live[i])
+        continue;
+      T *s = new (frames[i]) T(std::forward<Args>(args)...);
+      live[i] = s;
+      fresh[i] = i > cursor;
+      return s;
+    }
+    overflows++;
+    return nullptr;
+  }
+
+  void clear()
+  {
+    for (int i = 0; i < N; i++)
+      finish(i);
+    pending = 0;
+  }
+
+  // Raises event bits, seen by waiting scripts on the next step()
+  void signal(uint32_t events) { pending |= events; }
+
+  int count() const
+  {
+    int n = 0;
+    for (int i = 0; i < N; i++)
+      if (live[i])
+        n++;
+    return n;
+  }
+
+  // One tick: resumes every script whose wait is over
+  void step()
+  {
+    uint32_t events = pending;
+    pending = 0;
+
+    for (cursor = 0; cursor < N; cursor++)
+    {
+      int i = cursor;
+      Script *s = live[i];
+      if (!s)
+        continue;
+      if (fresh[i])
+      {
+        fresh[i] = false;
+        continue;
+      }
+      if (s->waitTicks && --s->waitTicks)
+        continue;
+      if (s->waitEvents)
+      {
+        if (!(events & s->waitEvents))
+          continue;
+        s->fired = events & s->waitEvents;
+        s->waitEvents = 0;
+      }
+      if (!s->resume())
+        finish(i);
+    }
+  }
+
+private:
+  void finish(int i)
+  {
+    if (!live[i])
+      return;
+    live[i]->~Script();
+    live[i] = nullptr;
+    fresh[i] = false;
+  }
+};
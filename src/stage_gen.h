@@ -0,0 +1,317 @@
+// ============================================================================
+// stage_gen.h - Procedural stage segments, generated a little each tick
+// ============================================================================
+//
+// An endless stage is cut into segments of SEGMENT_TICKS. Each segment is
+// a list of cues - a single enemy, a formation, a powerup - sorted by the
+// tick they fire on. StageGenerator builds segments ahead of the one being
+// played, one cue per work unit, and step() stops once its time slice is
+// used up, so generation never shows up as a frame spike.
+//
+// Every segment is generated from its own seed, mixed from the run seed
+// and the segment index, so the result depends only on those two - not on
+// how the work happened to be sliced, and not on the game's random().
+// If play reaches a segment that is not finished, segment() finishes it
+// on the spot and counts a miss.
+//
+// Cues stay free of game types: enemies and powerups are a variant number
+// (enemy tier, powerup kind) and formations name a path and shape index,
+// all within the limits passed to begin().
+//
+// ProceduralStageSource gives the background the same treatment: map rows
+// for the streamed stage (bg_stream.h) computed from the seed instead of
+// read from flash, with the tileset still loaded from the wrapped source.
+
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include "bg_stream.h"
+
+#ifndef SEGMENT_TICKS
+#define SEGMENT_TICKS 300
+#endif
+
+#define SEGMENT_MAX_CUES 24
+
+// Segments kept built: the one being played plus the ones ahead of it
+#define GEN_SLOTS 3
+
+// splitmix32 finaliser: spreads neighbouring inputs over the whole range
+static inline uint32_t mix32(uint32_t x)
+{
+  x += 0x9E3779B9;
+  x = (x ^ (x >> 16)) * 0x85EBCA6B;
+  x = (x ^ (x >> 13)) * 0xC2B2AE35;
+  return x ^ (x >> 16);
+}
+
+enum CueKind : uint8_t
+{
+  CUE_ENEMY,     // variant = enemy tier, x = spawn column
+  CUE_FORMATION, // variant = enemy tier, path and shape
+  CUE_POWERUP    // variant = powerup kind, x = spawn column
+};
+
+struct StageCue
+{
+  uint16_t tick; // into the segment
+  uint8_t kind;
+  uint8_t variant;
+  uint16_t x;
+  uint8_t path;
+  uint8_t shape;
+};
+
+struct StageSegment
+{
+  uint32_t index;
+  uint8_t cueCount;
+  StageCue cues[SEGMENT_MAX_CUES];
+};
+
+class StageGenerator
+{
+private:
+  StageSegment slots[GEN_SLOTS];
+  uint32_t seed = 0;
+  uint32_t next = 0;    // segment being built
+  uint32_t current = 0; // segment being played
+  uint16_t width = 320;
+  uint8_t paths = 1, shapes = 1;
+
+  // Build state for segment next
+  enum Phase : uint8_t
+  {
+    PLAN,
+    CUES,
+    SORT
+  };
+  uint8_t phase = PLAN;
+  uint32_t rng = 0;
+  uint8_t singles = 0, formations = 0, powerups = 0;
+
+  uint32_t rand(uint32_t n)
+  {
+    rng = mix32(rng);
+    return rng % n;
+  }
+
+  // One unit of work on segment next. False when far enough ahead.
+  bool work()
+  {
+    if (next >= current + GEN_SLOTS)
+      return false;
+    StageSegment &s = slots[next % GEN_SLOTS];
+    units++;
+
+    switch (phase)
+    {
+    case PLAN:
+    {
+      // Difficulty climbs for the first twenty segments, then holds
+      uint32_t level = min(next, (uint32_t)20);
+      rng = mix32(seed ^ mix32(next));
+      s.index = next;
+      s.cueCount = 0;
+      singles = 3 + level / 2;
+      formations = 1 + (level >= 4) + (level >= 10);
+      powerups = rand(100) < 60 ? 1 : 0;
+      phase = CUES;
+      return true;
+    }
+    case CUES:
+    {
+      StageCue &c = s.cues[s.cueCount];
+      uint32_t level = min(next, (uint32_t)20);
+      c.x = 30 + rand(width - 60);
+      c.path = c.shape = 0;
+      if (formations)
+      {
+        // Spread over the segment so they rarely overlap
+        int n = formations--;
+        c.kind = CUE_FORMATION;
+        c.tick = (n - 1) * SEGMENT_TICKS / 3 + rand(SEGMENT_TICKS / 6);
+        c.variant = level >= 8 && rand(2) ? 1 : 0;
+        c.path = rand(paths);
+        c.shape = rand(shapes);
+      }
+      else if (singles)
+      {
+        singles--;
+        uint32_t roll = rand(100);
+        c.kind = CUE_ENEMY;
+        c.tick = rand(SEGMENT_TICKS);
+        c.variant = roll < level * 2 ? 2 : roll < 30 + level ? 1 : 0;
+      }
+      else
+      {
+        powerups--;
+        c.kind = CUE_POWERUP;
+        c.tick = rand(SEGMENT_TICKS);
+        c.variant = rand(2);
+      }
+      s.cueCount++;
+      if (!formations && !singles && !powerups)
+        phase = SORT;
+      return true;
+    }
+    default:
+      // Insertion sort by tick; stable, so equal ticks keep their order
+      for (int i = 1; i < s.cueCount; i++)
+      {
+        StageCue c = s.cues[i];
+        int j = i;
+        for (; j > 0 && s.cues[j - 1].tick > c.tick; j--)
+          s.cues[j] = s.cues[j - 1];
+        s.cues[j] = c;
+      }
+      next++;
+      phase = PLAN;
+      return true;
+    }
+  }
+
+public:
+  uint32_t units = 0;  // work units done
+  uint32_t misses = 0; // segments play reached before they were built
+  uint32_t lastUs = 0; // time spent by the last step()
+  uint32_t maxUs = 0;
+
+  // Starts a run: forgets everything built and builds segment 0 now
+  void begin(uint32_t runSeed, uint16_t screenWidth, uint8_t pathCount, uint8_t shapeCount)
+  {
+    seed = runSeed;
+    width = screenWidth;
+    paths = pathCount;
+    shapes = shapeCount;
+    next = current = 0;
+    phase = PLAN;
+    units = misses = lastUs = maxUs = 0;
+    while (next == 0)
+      work();
+  }
+
+  // Builds ahead for up to budgetUs, at least one unit when there is work
+  void step(uint32_t budgetUs)
+  {
+    uint32_t t0 = micros();
+    while (work() && micros() - t0 < budgetUs)
+      ;
+    lastUs = micros() - t0;
+    maxUs = max(maxUs, lastUs);
+  }
+
+  // Segment k, finished on the spot if the slices have not got there.
+  // Moving back, or jumping ahead (a restored snapshot), rebuilds from k.
+  const StageSegment &segment(uint32_t k)
+  {
+    if (k < current || k > next || (k < next && slots[k % GEN_SLOTS].index != k))
+    {
+      next = k;
+      phase = PLAN;
+    }
+    current = k;
+    if (k == next)
+    {
+      misses++;
+      while (k == next)
+        work();
+    }
+    return slots[k % GEN_SLOTS];
+  }
+};
+
+// ---- Background ------------------------------------------------------------
+
+// Tile kinds in the order tools/build_stage.py builds the tileset
+enum StageTile : uint8_t
+{
+  TILE_SPACE,
+  TILE_STARS,
+  TILE_CLUSTER,
+  TILE_NEBULA_EDGE,
+  TILE_NEBULA,
+  TILE_DEBRIS
+};
+
+// Serves the header and tileset from inner and makes up the map: every
+// row is a pure function of the seed and the row number, so the reader
+// task can ask for any row in any order. Mirrors make_map() in
+// build_stage.py - nebula bands every 64 rows, scattered stars and debris.
+class ProceduralStageSource : public StageSource
+{
+private:
+  StageSource &inner;
+  std::atomic<uint32_t> seed;
+  uint32_t mapOffset = 0;
+  uint8_t columns = 0;
+  uint16_t tileCount = 0;
+
+  uint8_t tileAt(uint32_t s, uint32_t row, uint32_t col) const
+  {
+    static const uint8_t widths[] = {0, 0, 2, 3, 4};
+    uint32_t band = mix32(s ^ mix32(row / 64));
+    uint32_t nebulaWidth = widths[band % 5];
+    uint32_t nebulaLeft = (band >> 8) % (columns - min(nebulaWidth, (uint32_t)columns - 1));
+    bool inside = col >= nebulaLeft && col < nebulaLeft + nebulaWidth;
+
+    uint8_t kind;
+    if (inside && row % 64 < 2)
+      kind = TILE_NEBULA_EDGE;
+    else if (inside && row % 64 < 40)
+      kind = TILE_NEBULA;
+    else
+    {
+      uint32_t roll = mix32(s ^ mix32(row * STAGE_MAX_COLUMNS + col + 0x5EED)) % 1000;
+      kind = roll < 20 ? TILE_DEBRIS : roll < 80 ? TILE_CLUSTER : roll < 500 ? TILE_STARS : TILE_SPACE;
+    }
+    return kind < tileCount ? kind : kind % tileCount;
+  }
+
+public:
+  ProceduralStageSource(StageSource &src, uint32_t runSeed) : inner(src), seed(runSeed) {}
+
+  // Rows already streamed keep the old seed; seek the streamer afterwards
+  // to drop them
+  void reseed(uint32_t runSeed) { seed.store(runSeed); }
+
+  bool read(uint32_t offset, void *dst, size_t len) override
+  {
+    if (!columns)
+    {
+      StageHeader h;
+      if (!inner.read(0, &h, sizeof(h)) || h.magic != STAGE_MAGIC || !h.columns || !h.tileCount)
+        return false;
+      columns = h.columns;
+      tileCount = h.tileCount;
+      mapOffset = sizeof(h) + (uint32_t)h.tileSize * h.tileSize * 2 * h.tileCount;
+    }
+
+    if (offset + len <= mapOffset)
+    {
+      if (!inner.read(offset, dst, len))
+        return false;
+      // An endless map: the streamer wraps at rows, so make that never
+      if (offset < sizeof(StageHeader))
+      {
+        StageHeader h;
+        inner.read(0, &h, sizeof(h));
+        h.rows = 0xFFFFFFFF / columns;
+        memcpy(dst, (const uint8_t *)&h + offset, min(len, sizeof(h) - offset));
+      }
+      return true;
+    }
+    if (offset < mapOffset)
+      return false;
+
+    uint32_t s = seed.load();
+    uint8_t *out = (uint8_t *)dst;
+    for (size_t i = 0; i < len; i++)
+    {
+      uint32_t pos = offset - mapOffset + i;
+      out[i] = tileAt(s, pos / columns, pos % columns);
+    }
+    return true;
+  }
+};
@@ -0,0 +1,86 @@
+// ============================================================================
+// telemetry.h - Binary per-frame telemetry stream
+// ============================================================================
+//
+// Wire format, little endian:
+//
+//   0xA5 0x5A | len (u8) | version (u8) | payload (len bytes) | crc16 (u16)
+//
+// The CRC (CCITT, init 0xFFFF) covers len, version and payload, so a reader
+// can resynchronise on the sync bytes after noise or interleaved text.
+// Decode with tools/telemetry_decode.py.
+
+#pragma once
+
+#include <Arduino.h>
+#include "ring_buffer.h"
+#include "profiler.h"
+
+#define TELEMETRY_VERSION 2
+
+struct __attribute__((packed)) TelemetryRecord
+{
+  uint32_t frame;
+  uint32_t frameUs;
+  uint16_t spanUs[SPAN_COUNT];
+  uint8_t poolCount[6];
+  uint16_t collisionTests;
+  uint32_t pixelsDrawn;
+  uint32_t bytesFlushed;
+  uint32_t heapFree;
+  uint16_t culled;
+  uint16_t fastDraws;
+};
+
+static inline uint16_t crc16Update(uint16_t crc, const uint8_t *data, size_t len)
+{
+  // Nibble table keeps this to 32 bytes of flash and two lookups per byte
+  static const uint16_t table[16] = {
+      0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+      0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF};
+  for (size_t i = 0; i < len; i++)
+  {
+    crc = (crc << 4) ^ table[(crc >> 12) ^ (data[i] >> 4)];
+    crc = (crc << 4) ^ table[(crc >> 12) ^ (data[i] & 0x0F)];
+  }
+  return crc;
+}
+
+class TelemetryStream
+{
+private:
+  static const size_t FRAME_SIZE = 4 + sizeof(TelemetryRecord) + 2;
+
+  // Trace channel: the game loop only copies a record in, framing and CRC
+  // happen when the record is written out.
+  SpscRing<TelemetryRecord, 8> queue;
+  uint32_t dropped = 0;
+
+public:
+  void submit(const TelemetryRecord &rec)
+  {
+    if (!queue.push(rec))
+      dropped++;
+  }
+
+  // Writes whole frames while the UART TX buffer has room for them
+  void pump()
+  {
+    TelemetryRecord rec;
+    while (Serial.availableForWrite() >= (int)FRAME_SIZE && queue.pop(rec))
+    {
+      uint8_t frame[FRAME_SIZE];
+      frame[0] = 0xA5;
+      frame[1] = 0x5A;
+      frame[2] = sizeof(TelemetryRecord);
+      frame[3] = TELEMETRY_VERSION;
+      memcpy(frame + 4, &rec, sizeof(rec));
+      uint16_t crc = crc16Update(0xFFFF, frame + 2, 2 + sizeof(rec));
+      frame[FRAME_SIZE - 2] = crc & 0xFF;
+      frame[FRAME_SIZE - 1] = crc >> 8;
+      Serial.write(frame, FRAME_SIZE);
+    }
+  }
+
+  uint32_t droppedCount() const { return dropped; }
+};
@@ -0,0 +1,228 @@
+// ============================================================================
+// world.h - Placed entities in a world larger than the screen
+// ============================================================================
+//
+// The world is cut into SECTOR_SIZE squares. Everything placed in it sits
+// dormant as a 6-byte Placement, bucketed by sector, until the camera
+// comes near; activate() then hands it to the game to spawn as a live
+// entity. Each call only looks at the sectors overlapping the wake
+// window, so its cost follows what is near the camera, not how much the
+// world holds.
+//
+// World y grows up the stage from where the run began, the same way the
+// streamed map counts rows; x is the same as on screen. Scrolling only
+// moves forward, so a placement woken once is never put back to sleep.
+//
+// Fill a world with place() between begin() and finish(). finish() sorts
+// the placements into sector buckets with one counting pass. A released
+// world is empty: activate() and wakeBelow() find nothing in it.
+
+#pragma once
+
+#include <Arduino.h>
+
+#define SECTOR_SIZE 256
+
+struct Placement
+{
+  uint16_t x;    // world x
+  uint8_t y;     // world y within the sector
+  uint8_t type;  // the game's entity type
+  uint8_t param; // free for the game, e.g. a variant
+  uint8_t awake; // already handed out
+};
+
+class World
+{
+private:
+  Placement *items = nullptr;
+  uint32_t *sectorStart = nullptr; // bucket s is items[sectorStart[s]..sectorStart[s+1])
+  uint16_t *staging = nullptr;     // sector of each placement until finish()
+  uint32_t *fill = nullptr;        // finish()'s next unsorted slot per sector
+  uint32_t capacity = 0;
+  uint16_t columns = 0;
+  uint16_t rows = 0;
+
+  static void *allocate(size_t bytes)
+  {
+#ifdef BOARD_HAS_PSRAM
+    return ps_malloc(bytes);
+#else
+    return malloc(bytes);
+#endif
+  }
+
+public:
+  uint32_t count = 0;
+  uint32_t woken = 0;   // placements handed out so far
+  uint32_t scanned = 0; // placements looked at by the last activate()
+
+  ~World() { release(); }
+
+  void release()
+  {
+    free(items);
+    free(sectorStart);
+    free(staging);
+    free(fill);
+    items = nullptr;
+    sectorStart = nullptr;
+    staging = nullptr;
+    fill = nullptr;
+    capacity = count = woken = scanned = 0;
+    columns = rows = 0;
+  }
+
+  // Room for up to maxPlacements in a width x height world. Storage is
+  // kept between calls when it is already big enough.
+  bool begin(uint32_t width, uint32_t height, uint32_t maxPlacements)
+  {
+    uint16_t c = (width + SECTOR_SIZE - 1) / SECTOR_SIZE;
+    uint32_t r = (height + SECTOR_SIZE - 1) / SECTOR_SIZE;
+    if ((uint32_t)c * r > 0xFFFF)
+      return false; // staging holds sector numbers in 16 bits
+    if (maxPlacements > capacity || (uint32_t)c * r != (uint32_t)columns * rows)
+    {
+      release();
+      items = (Placement *)allocate(maxPlacements * sizeof(Placement));
+      sectorStart = (uint32_t *)allocate(((size_t)c * r + 1) * sizeof(uint32_t));
+      staging = (uint16_t *)allocate(maxPlacements * sizeof(uint16_t));
+      fill = (uint32_t *)allocate((size_t)c * r * sizeof(uint32_t));
+      if (!items || !sectorStart || !staging || !fill)
+      {
+        release();
+        return false;
+      }
+      capacity = maxPlacements;
+    }
+    columns = c;
+    rows = r;
+    count = woken = scanned = 0;
+    return true;
+  }
+
+  uint32_t sectors() const { return (uint32_t)columns * rows; }
+  uint32_t bytes() const { return capacity * (sizeof(Placement) + sizeof(uint16_t)) + (sectors() * 2 + 1) * 4; }
+
+  bool place(uint8_t type, uint32_t x, uint32_t y, uint8_t param = 0)
+  {
+    uint32_t c = x / SECTOR_SIZE, r = y / SECTOR_SIZE;
+    if (count == capacity || c >= columns || r >= rows)
+      return false;
+    items[count] = {(uint16_t)x, (uint8_t)(y % SECTOR_SIZE), type, param, 0};
+    staging[count] = r * columns + c;
+    count++;
+    return true;
+  }
+
+  // Sorts the placements into their sector buckets. False when begin()
+  // did not succeed; release() the world and treat it as empty.
+  bool finish()
+  {
+    if (!sectorStart)
+      return false;
+    uint32_t n = sectors();
+    memset(sectorStart, 0, (n + 1) * sizeof(uint32_t));
+    for (uint32_t i = 0; i < count; i++)
+      sectorStart[staging[i] + 1]++;
+    for (uint32_t s = 0; s < n; s++)
+      sectorStart[s + 1] += sectorStart[s];
+
+    // In place, bucket by bucket: fill[s] is the next unsorted slot of
+    // sector s, and anything found there that belongs elsewhere is swapped
+    // into its own bucket
+    memcpy(fill, sectorStart, n * sizeof(uint32_t));
+    for (uint32_t s = 0; s < n; s++)
+      while (fill[s] < sectorStart[s + 1])
+      {
+        uint32_t i = fill[s];
+        uint16_t t = staging[i];
+        if (t == s)
+        {
+          fill[s]++;
+          continue;
+        }
+        uint32_t dst = fill[t]++;
+        Placement p = items[dst];
+        items[dst] = items[i];
+        items[i] = p;
+        staging[i] = staging[dst];
+        staging[dst] = t;
+      }
+    return true;
+  }
+
+  // Hands every dormant placement inside [x0, x1) x [y0, y1) to
+  // spawn(type, x, y, param), which returns false to leave it asleep for
+  // another try (its pool was full). Returns how many woke.
+  template <class F>
+  uint32_t activate(int32_t x0, int32_t y0, int32_t x1, int32_t y1, F spawn)
+  {
+    scanned = 0;
+    if (!count)
+      return 0;
+    int32_t c0 = max(x0, 0) / SECTOR_SIZE, c1 = min((x1 - 1) / SECTOR_SIZE, (int32_t)columns - 1);
+    int32_t r0 = max(y0, 0) / SECTOR_SIZE, r1 = min((y1 - 1) / SECTOR_SIZE, (int32_t)rows - 1);
+
+    uint32_t n = 0;
+    for (int32_t r = r0; r <= r1; r++)
+      for (int32_t c = c0; c <= c1; c++)
+      {
+        uint32_t s = r * columns + c;
+        int32_t baseY = r * SECTOR_SIZE;
+        for (uint32_t i = sectorStart[s]; i < sectorStart[s + 1]; i++)
+        {
+          Placement &p = items[i];
+          scanned++;
+          int32_t y = baseY + p.y;
+          if (p.awake || p.x < x0 || p.x >= x1 || y < y0 || y >= y1)
+            continue;
+          if (spawn(p.type, (int32_t)p.x, y, p.param))
+          {
+            p.awake = 1;
+            n++;
+          }
+        }
+      }
+    woken += n;
+    return n;
+  }
+
+  // Awake flags as a bitset, bit i for the i-th placement in bucket order.
+  // A world built again from the same seed has the same order, so this
+  // restores a run exactly where wakeBelow() only approximates it.
+  void saveAwake(uint8_t *bits, uint32_t bytes) const
+  {
+    memset(bits, 0, bytes);
+    for (uint32_t i = 0; i < count && i / 8 < bytes; i++)
+      if (items[i].awake)
+        bits[i / 8] |= 1 << (i % 8);
+  }
+
+  void loadAwake(const uint8_t *bits, uint32_t bytes)
+  {
+    woken = 0;
+    for (uint32_t i = 0; i < count && i / 8 < bytes; i++)
+    {
+      items[i].awake = bits[i / 8] >> (i % 8) & 1;
+      woken += items[i].awake;
+    }
+  }
+
+  // Marks everything below y as already woken, for restoring a run part
+  // way through without replaying what the camera has passed
+  void wakeBelow(int32_t y)
+  {
+    for (int32_t r = 0; r < rows && r * SECTOR_SIZE < y; r++)
+      for (int32_t c = 0; c < columns; c++)
+      {
+        uint32_t s = r * columns + c;
+        for (uint32_t i = sectorStart[s]; i < sectorStart[s + 1]; i++)
+          if (!items[i].awake && r * SECTOR_SIZE + items[i].y < y)
+          {
+            items[i].awake = 1;
+            woken++;
+          }
+      }
+  }
+};
@@ -0,0 +1,120 @@
+// ============================================================================
+// test_main.cpp - SpscRing producer/consumer stress test, for ThreadSanitizer
+// ============================================================================
+//
+// Run with the native_ring_stress environment:
+//
+//   pio test -e native_ring_stress
+//
+// One thread pushes a numbered sequence while another pops it, each side
+// switching at random between single and batch calls of random sizes, on
+// rings small enough that the indices wrap constantly. The consumer checks
+// every item arrives once, in order and untorn (each carries its number's
+// complement). Fails on any mismatch; TSan reports any race.
+// A side that makes no progress yields, so it also runs on one core.
+
+#include <stdio.h>
+#include <thread>
+#include <unity.h>
+#include "ring_buffer.h"
+
+#define STRESS_ITEMS 500000
+
+struct StressItem
+{
+  uint32_t seq;
+  uint32_t check; // ~seq
+  uint64_t pad;   // makes the copy too wide to be atomic by accident
+};
+
+static uint32_t xorshift(uint32_t &s)
+{
+  s ^= s << 13;
+  s ^= s >> 17;
+  s ^= s << 5;
+  return s;
+}
+
+template <size_t N>
+static bool stress(const char *name)
+{
+  static SpscRing<StressItem, N> ring;
+  uint32_t errors = 0, maxSize = 0;
+
+  std::thread producer([] {
+    uint32_t rng = 0x1234567;
+    StressItem batch[N + 2];
+    uint32_t next = 0;
+    while (next < STRESS_ITEMS)
+    {
+      if (xorshift(rng) & 1)
+      {
+        StressItem item = {next, ~next, next};
+        if (ring.push(item))
+          next++;
+        else
+          std::this_thread::yield();
+      }
+      else
+      {
+        size_t want = 1 + xorshift(rng) % (N + 2);
+        if (want > STRESS_ITEMS - next)
+          want = STRESS_ITEMS - next;
+        for (size_t i = 0; i < want; i++)
+          batch[i] = {next + (uint32_t)i, ~(next + (uint32_t)i), next + i};
+        size_t pushed = ring.pushBatch(batch, want);
+        if (!pushed)
+          std::this_thread::yield();
+        next += pushed;
+      }
+    }
+  });
+
+  uint32_t rng = 0x89ABCDE;
+  StressItem batch[N + 2];
+  uint32_t expected = 0;
+  while (expected < STRESS_ITEMS)
+  {
+    size_t got;
+    if (xorshift(rng) & 1)
+      got = ring.pop(batch[0]) ? 1 : 0;
+    else
+      got = ring.popBatch(batch, 1 + xorshift(rng) % (N + 2));
+    if (!got)
+      std::this_thread::yield();
+    for (size_t i = 0; i < got; i++, expected++)
+      if (batch[i].seq != expected || batch[i].check != ~expected || batch[i].pad != expected)
+      {
+        if (errors++ < 5)
+          printf("RING %s item %u arrived as %u/%08x\n", name, expected, batch[i].seq, batch[i].check);
+        expected = batch[i].seq;
+      }
+    size_t s = ring.size();
+    if (s > maxSize)
+      maxSize = s;
+  }
+  producer.join();
+
+  bool ok = errors == 0 && maxSize <= N && ring.empty();
+  printf("RING %-8s %u items, %u errors, max size %u of %u, %s\n", name, STRESS_ITEMS, errors, maxSize,
+         (unsigned)N, ok ? "ok" : "FAILED");
+  return ok;
+}
+
+void setUp() {}
+void tearDown() {}
+
+// Two slots: full and empty nearly every call
+static void test_ring_2() { TEST_ASSERT_TRUE(stress<2>("N=2")); }
+static void test_ring_8() { TEST_ASSERT_TRUE(stress<8>("N=8")); }
+// The size InputSystem and the streamer use
+static void test_ring_64() { TEST_ASSERT_TRUE(stress<64>("N=64")); }
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_ring_2);
+  RUN_TEST(test_ring_8);
+  RUN_TEST(test_ring_64);
+  return UNITY_END();
+}
@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""Pack sprites into an asset bundle for the "assets" flash partition.
+
+Sprites are read from C headers holding RGB565 arrays in the grafx.h
+style ("// name - WxH pixels" comment followed by the array) and written
+in SpriteId order, so entry i of the index is SpriteId i. See
+src/assets.h for the layout.
+
+    python3 tools/build_assets.py src/grafx.h -o assets.bin [--compress]
+    esptool.py write_flash 0x310000 assets.bin
+
+With --compress each sprite is stored RLE encoded whenever that is
+smaller; the firmware expands those through its sprite cache.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+# Keep in sync with SpriteId in src/assets.h
+SPRITES = [
+    "player_ship_map",
+    "enemy_basic_map",
+    "enemy_fast_map",
+    "enemy_tank_map",
+    "bullet_player_map",
+    "bullet_enemy_map",
+    "powerup_health_map",
+    "powerup_weapon_map",
+    "explosion_map",
+]
+
+MAGIC = 0x42415353
+VERSION = 1
+FORMAT_RGB565 = 0
+FORMAT_RLE565 = 1
+MAX_RUN = 0x7FFF
+HEADER = struct.Struct("<IHHI")
+ENTRY = struct.Struct("<HHBBHII")
+PARTITION_SIZE = 0xF0000
+
+SIZE_COMMENT = re.compile(r"//\s*(\w+)\s*-\s*(\d+)x(\d+) pixels")
+ARRAY = re.compile(r"const\s+uint16_t\s+(\w+)\[\]\s*(?:PROGMEM)?\s*=\s*\{([^}]*)\}", re.S)
+
+
+def read_sprites(paths):
+    sprites = {}
+    for path in paths:
+        with open(path) as f:
+            text = f.read()
+        sizes = {m.group(1): (int(m.group(2)), int(m.group(3))) for m in SIZE_COMMENT.finditer(text)}
+        for m in ARRAY.finditer(text):
+            name = m.group(1)
+            pixels = [int(v, 0) for v in m.group(2).replace("\n", " ").split(",") if v.strip()]
+            if name not in sizes:
+                print("warning: %s has no size comment, skipped" % name, file=sys.stderr)
+                continue
+            w, h = sizes[name]
+            if len(pixels) != w * h:
+                raise ValueError("%s: %d pixels, expected %dx%d" % (name, len(pixels), w, h))
+            sprites[name] = (w, h, pixels)
+    return sprites
+
+
+def rle565(pixels):
+    """Runs of 3+ equal pixels become (0x8000|n, px), the rest literals."""
+    out, literal = [], []
+    i = 0
+    while i < len(pixels):
+        run = 1
+        while i + run < len(pixels) and pixels[i + run] == pixels[i] and run < MAX_RUN:
+            run += 1
+        if run >= 3:
+            if literal:
+                out += [len(literal)] + literal
+                literal = []
+            out += [0x8000 | run, pixels[i]]
+            i += run
+        else:
+            literal.append(pixels[i])
+            if len(literal) == MAX_RUN:
+                out += [len(literal)] + literal
+                literal = []
+            i += 1
+    if literal:
+        out += [len(literal)] + literal
+    return out
+
+
+def build(sprites, compress=False):
+    index_end = HEADER.size + ENTRY.size * len(SPRITES)
+    offset = (index_end + 3) & ~3
+    entries, blobs = [], []
+    for name in SPRITES:
+        if name not in sprites:
+            raise KeyError("sprite %s not found in inputs" % name)
+        w, h, pixels = sprites[name]
+        fmt, words = FORMAT_RGB565, pixels
+        if compress:
+            packed = rle565(pixels)
+            if len(packed) < len(pixels):
+                fmt, words = FORMAT_RLE565, packed
+        data = struct.pack("<%dH" % len(words), *words)
+        entries.append(ENTRY.pack(w, h, fmt, 0, 0, offset, len(data)))
+        pad = (-len(data)) & 3
+        blobs.append(data + b"\0" * pad)
+        offset += len(data) + pad
+
+    body = b"".join(entries)
+    out = HEADER.pack(MAGIC, VERSION, len(SPRITES), offset) + body
+    out += b"\0" * (((index_end + 3) & ~3) - index_end)
+    out += b"".join(blobs)
+    assert len(out) == offset
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("headers", nargs="+", help="C headers with RGB565 sprite arrays")
+    parser.add_argument("-o", "--output", default="assets.bin")
+    parser.add_argument("--compress", action="store_true", help="RLE encode sprites where smaller")
+    args = parser.parse_args()
+
+    bundle = build(read_sprites(args.headers), args.compress)
+    if len(bundle) > PARTITION_SIZE:
+        print("bundle is %d bytes, partition holds %d" % (len(bundle), PARTITION_SIZE), file=sys.stderr)
+        return 1
+    with open(args.output, "wb") as f:
+        f.write(bundle)
+    print("%s: %d sprites, %d bytes" % (args.output, len(SPRITES), len(bundle)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+"""Generate a streamed stage for the "stage" flash partition.
+
+Builds a small procedural tileset (deep space, star clusters, nebula and
+debris) and a tall tile map that drifts between them, in the layout
+src/bg_stream.h reads. Only the tileset is loaded into RAM on the board;
+map rows are streamed while the stage scrolls.
+
+    python3 tools/build_stage.py -o stage.bin [--rows 4096] [--seed 1]
+    esptool.py write_flash 0x210000 stage.bin
+"""
+
+import argparse
+import random
+import struct
+import sys
+
+MAGIC = 0x47545353
+VERSION = 1
+HEADER = struct.Struct("<IHBBIHH")
+PARTITION_SIZE = 0x100000
+MAX_COLUMNS = 16
+# Keep in sync with src/main.cpp and BackgroundStreamer::WINDOW
+SCREEN_WIDTH, SCREEN_HEIGHT = 320, 480
+WINDOW = 32
+MIN_TILE = 16  # make_tile() places debris at least 8 px from each edge
+
+SPACE, STARS, CLUSTER, NEBULA_EDGE, NEBULA, DEBRIS = range(6)
+
+
+def rgb565(r, g, b):
+    return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+
+
+def make_tile(kind, size, rng):
+    px = [0] * (size * size)
+
+    def star(n, bright):
+        for _ in range(n):
+            v = rng.randint(bright // 2, bright)
+            px[rng.randrange(size * size)] = rgb565(v, v, v)
+
+    if kind in (NEBULA_EDGE, NEBULA):
+        for y in range(size):
+            for x in range(size):
+                fade = y / (size - 1) if kind == NEBULA_EDGE else 1.0
+                n = rng.randint(0, 24)
+                px[y * size + x] = rgb565(int((40 + n) * fade), 0, int((60 + n) * fade))
+    if kind == DEBRIS:
+        cx, cy, r = rng.randint(8, size - 8), rng.randint(8, size - 8), rng.randint(4, 7)
+        for y in range(size):
+            for x in range(size):
+                if (x - cx) ** 2 + (y - cy) ** 2 <= r * r:
+                    px[y * size + x] = rgb565(90, 70, 50) if x + y < cx + cy else rgb565(50, 40, 30)
+    star({SPACE: 1, STARS: 4, CLUSTER: 12, NEBULA_EDGE: 2, NEBULA: 3, DEBRIS: 1}[kind],
+         255 if kind == CLUSTER else 180)
+    return px
+
+
+def make_map(rows, columns, rng):
+    out = []
+    nebula_left, nebula_width = 0, 0
+    for r in range(rows):
+        # Every so often a nebula band drifts across part of the screen
+        if r % 64 == 0:
+            nebula_width = rng.choice([0, 0, 2, 3, 4])
+            nebula_left = rng.randint(0, columns - max(nebula_width, 1))
+        row = []
+        for c in range(columns):
+            inside = nebula_left <= c < nebula_left + nebula_width
+            if inside and r % 64 in (0, 1):
+                row.append(NEBULA_EDGE)
+            elif inside and r % 64 < 40:
+                row.append(NEBULA)
+            else:
+                roll = rng.random()
+                row.append(DEBRIS if roll < 0.02 else CLUSTER if roll < 0.08 else
+                           STARS if roll < 0.5 else SPACE)
+        out.append(row)
+    return out
+
+
+def build(rows, columns, tile_size, seed):
+    rng = random.Random(seed)
+    tiles = [make_tile(kind, tile_size, rng) for kind in range(DEBRIS + 1)]
+    grid = make_map(rows, columns, rng)
+    out = HEADER.pack(MAGIC, VERSION, tile_size, columns, rows, len(tiles), 0)
+    for t in tiles:
+        out += struct.pack("<%dH" % len(t), *t)
+    for row in grid:
+        out += bytes(row)
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-o", "--output", default="stage.bin")
+    parser.add_argument("--rows", type=int, default=4096, help="map rows (stage loops after these)")
+    parser.add_argument("--columns", type=int, default=10)
+    parser.add_argument("--tile", type=int, default=32, help="tile size in pixels")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    # The same checks BackgroundStreamer::begin() makes on the board
+    if not 0 < args.columns <= MAX_COLUMNS:
+        parser.error("--columns must be 1..%d" % MAX_COLUMNS)
+    if not MIN_TILE <= args.tile <= 255:
+        parser.error("--tile must be %d..255" % MIN_TILE)
+    if SCREEN_HEIGHT // args.tile + 2 > WINDOW:
+        parser.error("--tile %d puts more rows on screen than the streamer's %d-row window" %
+                     (args.tile, WINDOW))
+    if args.columns * args.tile < SCREEN_WIDTH:
+        parser.error("--columns %d x --tile %d covers %d of the %d px screen width" %
+                     (args.columns, args.tile, args.columns * args.tile, SCREEN_WIDTH))
+    if args.rows <= 0:
+        parser.error("--rows must be positive")
+    stage = build(args.rows, args.columns, args.tile, args.seed)
+    if len(stage) > PARTITION_SIZE:
+        print("stage is %d bytes, partition holds %d" % (len(stage), PARTITION_SIZE), file=sys.stderr)
+        return 1
+    with open(args.output, "wb") as f:
+        f.write(stage)
+    print("%s: %d rows x %d columns, %d bytes" % (args.output, args.rows, args.columns, len(stage)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
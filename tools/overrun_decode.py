@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+"""Extract frame overrun dumps from a serial log.
+
+The firmware streams each dump as "OVR BEGIN ...", a run of "OVR <hex>"
+lines and "OVR END". Every dump found is written as a raw .ovr file (the
+exact OverrunDump bytes, loadable with Game::restore) and summarised.
+host_bench --ovr FILE re-runs and times the frame a dump holds.
+
+    python3 tools/overrun_decode.py serial.log [-o outdir]
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+SPANS = ["input", "update", "sound", "draw", "push"]
+POOLS = ["enemies", "player_bullets", "enemy_bullets", "powerups", "explosions", "particles"]
+STATES = ["TITLE", "PLAYING", "GAME_OVER"]
+TYPES = ["PLAYER", "ENEMY_BASIC", "ENEMY_FAST", "ENEMY_TANK", "BULLET_PLAYER", "BULLET_ENEMY",
+         "POWERUP_WEAPON", "POWERUP_HEALTH", "EXPLOSION", "PARTICLE"]
+MAX_FORMATIONS = 4  # keep in sync with src/main.cpp
+NO_FORMATION = 0xFF
+
+HEADER = struct.Struct("<IIII%dI%dHbbBB" % (len(SPANS), len(POOLS)))
+SNAPSHOT = struct.Struct("<BBBBihHIIIIIHHI")
+FORMATION = struct.Struct("<BBBBhh")
+ENTITY = struct.Struct("<BBBBhhhhhBBHBB")
+MAGIC = 0x4F56524E
+
+
+def read_dumps(lines):
+    data = None
+    for line in lines:
+        line = line.strip()
+        if line.startswith("OVR BEGIN"):
+            data = bytearray()
+        elif line == "OVR END":
+            if data is not None:
+                yield bytes(data)
+            data = None
+        elif line.startswith("OVR ") and data is not None:
+            data += bytes.fromhex(line[4:])
+
+
+def describe(blob):
+    fields = HEADER.unpack_from(blob, 0)
+    magic, frame, frame_us, budget_us = fields[:4]
+    if magic != MAGIC:
+        raise ValueError("bad magic %08x" % magic)
+    spans = fields[4:4 + len(SPANS)]
+    pools = fields[4 + len(SPANS):4 + len(SPANS) + len(POOLS)]
+    move_x, move_y, fire, touching = fields[-4:]
+
+    snap_off = HEADER.size
+    (state, lives, wave, weapon, score, scroll, count, since_spawn, since_shot, since_formation,
+     seed, stage_tick, stage_cue, _, rng) = SNAPSHOT.unpack_from(blob, snap_off)
+
+    out = []
+    out.append("frame %d: %.1f ms (budget %.1f ms, x%.1f)" %
+               (frame, frame_us / 1000.0, budget_us / 1000.0, frame_us / float(budget_us)))
+    out.append("  spans: " + ", ".join("%s=%.2fms" % (n, us / 1000.0) for n, us in zip(SPANS, spans)))
+    out.append("  pools: " + ", ".join("%s=%d" % (n, c) for n, c in zip(POOLS, pools)))
+    out.append("  input: move=(%d,%d) fire=%d touching=%d" % (move_x, move_y, fire, touching))
+    out.append("  game: state=%s score=%d lives=%d wave=%d weapon=%d scroll=%.1f" %
+               (STATES[state] if state < len(STATES) else state, score, lives, wave, weapon, scroll / 16.0))
+    out.append("  timers: since_spawn=%dms since_shot=%dms since_formation=%dms, %d entities" %
+               (since_spawn, since_shot, since_formation, count))
+    out.append("  stage: seed=%08x tick=%d cue=%d rng=%08x" % (seed, stage_tick, stage_cue, rng))
+    ent_off = snap_off + SNAPSHOT.size + FORMATION.size * MAX_FORMATIONS
+    out.append("  " + describe_entity("player", ENTITY.unpack_from(blob, ent_off)))
+    for n in range(count):
+        off = ent_off + ENTITY.size * (n + 1)
+        if off + ENTITY.size > len(blob):
+            out.append("  (dump ends after %d of %d entities)" % (n, count))
+            break
+        fields = ENTITY.unpack_from(blob, off)
+        pool = POOLS[fields[0]] if fields[0] < len(POOLS) else "pool%d" % fields[0]
+        out.append("  " + describe_entity("%s[%d]" % (pool, fields[1]), fields))
+    return "\n".join(out)
+
+
+def describe_entity(name, fields):
+    _, _, kind, anim_frame, x, y, vx, vy, health, w, h, _, formation, member = fields
+    text = "%-18s %-14s pos=(%.1f,%.1f) vel=(%.2f,%.2f) hp=%d size=%dx%d frame=%d" % (
+        name, TYPES[kind] if kind < len(TYPES) else kind, x / 16.0, y / 16.0, vx / 256.0, vy / 256.0,
+        health, w, h, anim_frame)
+    if formation != NO_FORMATION:
+        text += " formation=%d.%d" % (formation, member)
+    return text
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", help="serial log captured from the device")
+    parser.add_argument("-o", "--outdir", default=".", help="where to write .ovr files")
+    args = parser.parse_args()
+
+    with open(args.log, errors="replace") as f:
+        dumps = list(read_dumps(f))
+    if not dumps:
+        print("no overrun dumps found", file=sys.stderr)
+        return 1
+
+    for blob in dumps:
+        frame = struct.unpack_from("<I", blob, 4)[0]
+        path = os.path.join(args.outdir, "frame_%06d.ovr" % frame)
+        with open(path, "wb") as f:
+            f.write(blob)
+        print(describe(blob))
+        print("  -> %s" % path)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""Size the entity pools from recorded high-water marks.
+
+Reads the POOLS lines printed at the end of every run (device sessions
+and bench replays alike), takes the chosen percentile of each pool's
+per-run peak, adds headroom and writes src/pool_capacity.h.
+
+Lifetime totals and runs marked "tainted" (the console forced spawns or
+capped a pool) are skipped: their peaks and overflows are not real demand.
+
+A run that overflowed a pool only shows that demand exceeded the capacity
+it ran with, so for that pool the capacity is treated as a lower bound
+and grown by --overflow-growth.
+
+Pools with a hard upper bound in the code are clamped to it, with a note:
+enemies are collision-tested through AabbSoA (src/aabb_kernel.h), whose
+32-bit overlap masks allow at most 32.
+
+    python3 tools/pool_sizing.py serial*.log --percentile 99 -o src/pool_capacity.h
+"""
+
+import argparse
+import math
+import re
+import sys
+
+POOLS = ["MAX_ENEMIES", "MAX_PLAYER_BULLETS", "MAX_ENEMY_BULLETS",
+         "MAX_POWERUPS", "MAX_EXPLOSIONS", "MAX_PARTICLES"]
+LIMITS = {"MAX_ENEMIES": 32}
+LINE = re.compile(r"^POOLS (\S+) cap=([\d,]+) hw=([\d,]+) of=([\d,]+)")
+
+
+def parse(paths):
+    runs = []
+    for path in paths:
+        with open(path, errors="replace") as f:
+            for line in f:
+                m = LINE.match(line.strip())
+                if not m or m.group(1).startswith(("lifetime", "tainted")):
+                    continue
+                cap, hw, of = (list(map(int, g.split(","))) for g in m.group(2, 3, 4))
+                if len(cap) == len(hw) == len(of) == len(POOLS):
+                    runs.append((m.group(1), cap, hw, of))
+    return runs
+
+
+def percentile(values, pct):
+    ordered = sorted(values)
+    rank = max(1, math.ceil(pct / 100.0 * len(ordered)))
+    return ordered[rank - 1]
+
+
+def size_pools(runs, pct, headroom, growth):
+    sizes = []
+    for p in range(len(POOLS)):
+        demand = []
+        for _, cap, hw, of in runs:
+            demand.append(math.ceil(cap[p] * growth) if of[p] else hw[p])
+        need = percentile(demand, pct)
+        sizes.append(max(1, math.ceil(need * (1 + headroom / 100.0))))
+    return sizes
+
+
+def clamp(sizes):
+    clamped = []
+    for p, name in enumerate(POOLS):
+        limit = LIMITS.get(name)
+        if limit is not None and sizes[p] > limit:
+            clamped.append((name, sizes[p], limit))
+            sizes[p] = limit
+    return clamped
+
+
+def render(sizes, runs, pct, headroom):
+    out = ["// ============================================================================",
+           "// pool_capacity.h - Entity pool capacities",
+           "// ============================================================================",
+           "//",
+           "// Generated by tools/pool_sizing.py from %d runs: p%g of per-run peak" % (len(runs), pct),
+           "// occupancy plus %g%% headroom. Any value can still be overridden with a" % headroom,
+           "// -D build flag.",
+           "",
+           "#pragma once",
+           ""]
+    for name, size in zip(POOLS, sizes):
+        out += ["#ifndef %s" % name, "#define %s %d" % (name, size), "#endif"]
+    return "\n".join(out) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("logs", nargs="+", help="serial logs containing POOLS lines")
+    parser.add_argument("--percentile", type=float, default=99.0)
+    parser.add_argument("--headroom", type=float, default=10.0, help="percent added on top")
+    parser.add_argument("--overflow-growth", type=float, default=1.5,
+                        help="demand assumed for a pool that overflowed, times its capacity")
+    parser.add_argument("-o", "--output", help="header to write (default: stdout)")
+    args = parser.parse_args()
+
+    runs = parse(args.logs)
+    if not runs:
+        print("no POOLS run lines found", file=sys.stderr)
+        return 1
+
+    sizes = size_pools(runs, args.percentile, args.headroom, args.overflow_growth)
+    clamped = clamp(sizes)
+    for p, name in enumerate(POOLS):
+        peaks = [hw[p] for _, _, hw, _ in runs]
+        overflowed = sum(1 for _, _, _, of in runs if of[p])
+        print("%-20s max peak %3d, %3d/%d runs overflowed -> %d" %
+              (name, max(peaks), overflowed, len(runs), sizes[p]), file=sys.stderr)
+    for name, wanted, limit in clamped:
+        print("note: %s wanted %d, clamped to %d (the most the code supports)" % (name, wanted, limit),
+              file=sys.stderr)
+
+    header = render(sizes, runs, args.percentile, args.headroom)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(header)
+    else:
+        sys.stdout.write(header)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
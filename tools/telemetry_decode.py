@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""Decode the binary telemetry stream captured from the device.
+
+Frames are located by their 0xA5 0x5A sync bytes and checked against
+their CRC, so text printed on the same port is skipped. Output is a CSV
+with one row per record, and optionally a columnar directory holding one
+raw little-endian array per field plus schema.json (readable with
+numpy.fromfile using the dtype given in the schema).
+
+    python3 tools/telemetry_decode.py capture.bin -o telemetry.csv [--columns outdir]
+"""
+
+import argparse
+import csv
+import json
+import os
+import struct
+import sys
+
+VERSION = 2
+SPANS = ["input", "update", "sound", "draw", "push"]
+POOLS = ["enemies", "player_bullets", "enemy_bullets", "powerups", "explosions", "particles"]
+
+# (column name, struct code, numpy dtype)
+FIELDS = ([("frame", "I", "<u4"), ("frame_us", "I", "<u4")] +
+          [("%s_us" % s, "H", "<u2") for s in SPANS] +
+          [("%s_count" % p, "B", "u1") for p in POOLS] +
+          [("collision_tests", "H", "<u2"), ("pixels_drawn", "I", "<u4"),
+           ("bytes_flushed", "I", "<u4"), ("heap_free", "I", "<u4"),
+           ("culled", "H", "<u2"), ("fast_draws", "H", "<u2")])
+RECORD = struct.Struct("<" + "".join(code for _, code, _ in FIELDS))
+
+
+def crc16(data, crc=0xFFFF):
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def decode(buf):
+    """Returns the records of every valid frame and per-kind error counts."""
+    stats = {"frames": 0, "crc_errors": 0, "unknown_version": 0}
+    i = 0
+    records = []
+    while True:
+        i = buf.find(b"\xa5\x5a", i)
+        if i < 0 or i + 4 > len(buf):
+            break
+        length, version = buf[i + 2], buf[i + 3]
+        end = i + 4 + length + 2
+        if end > len(buf):
+            # A false sync inside a payload, or a frame cut off at the end
+            i += 1
+            continue
+        payload = buf[i + 4:i + 4 + length]
+        crc = buf[end - 2] | (buf[end - 1] << 8)
+        if crc16(buf[i + 2:i + 4 + length]) != crc:
+            stats["crc_errors"] += 1
+            i += 1
+            continue
+        if version != VERSION or length != RECORD.size:
+            stats["unknown_version"] += 1
+            i = end
+            continue
+        records.append(RECORD.unpack(payload))
+        stats["frames"] += 1
+        i = end
+    return records, stats
+
+
+def write_columns(records, outdir):
+    os.makedirs(outdir, exist_ok=True)
+    schema = []
+    for col, (name, code, dtype) in enumerate(FIELDS):
+        with open(os.path.join(outdir, name + ".bin"), "wb") as f:
+            f.write(struct.pack("<%d%s" % (len(records), code), *(r[col] for r in records)))
+        schema.append({"name": name, "dtype": dtype, "file": name + ".bin"})
+    with open(os.path.join(outdir, "schema.json"), "w") as f:
+        json.dump({"rows": len(records), "columns": schema}, f, indent=2)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("capture", help="raw bytes captured from the serial port")
+    parser.add_argument("-o", "--output", default="telemetry.csv", help="CSV output path")
+    parser.add_argument("--columns", help="also write columnar output to this directory")
+    args = parser.parse_args()
+
+    with open(args.capture, "rb") as f:
+        records, stats = decode(f.read())
+
+    with open(args.output, "w", newline="") as f:
+        writer = csv.writer(f)
+        writer.writerow([name for name, _, _ in FIELDS])
+        writer.writerows(records)
+
+    if args.columns:
+        write_columns(records, args.columns)
+
+    print("%(frames)d records, %(crc_errors)d CRC errors, %(unknown_version)d skipped" % stats,
+          file=sys.stderr)
+    return 0 if records else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())